@@ -0,0 +1,30 @@
+# Geração das tabelas const de fonte e ícones a partir dos arquivos em assets/.
+# Usado pelo firmware e pelos testes no host.
+#
+# generate_assets(<diretório> <rle>) declara a regra que cria
+# <diretório>/assets.c e <diretório>/assets.h; com <rle> verdadeiro os
+# glifos são compactados com run-length.
+
+find_package(Python3 REQUIRED COMPONENTS Interpreter)
+
+set(ASSETS_SOURCE_DIR ${CMAKE_CURRENT_LIST_DIR}/..)
+
+function(generate_assets dir rle)
+    set(args
+            --font ${ASSETS_SOURCE_DIR}/assets/font8x8.bdf
+            --icons ${ASSETS_SOURCE_DIR}/assets/icons.txt
+            --out ${dir}
+            )
+    if (rle)
+        list(APPEND args --rle)
+    endif()
+    add_custom_command(
+            OUTPUT ${dir}/assets.c ${dir}/assets.h
+            COMMAND ${Python3_EXECUTABLE} ${ASSETS_SOURCE_DIR}/tools/gen_assets.py ${args}
+            DEPENDS
+                ${ASSETS_SOURCE_DIR}/tools/gen_assets.py
+                ${ASSETS_SOURCE_DIR}/assets/font8x8.bdf
+                ${ASSETS_SOURCE_DIR}/assets/icons.txt
+            COMMENT "Gerando tabelas de fonte e ícones em ${dir}"
+            )
+endfunction()
@@ -9,121 +9,6 @@
 volatile uint8_t current_number = 0;  // Número atual exibido
 volatile bool update_num_matrix = false; // Flag utilizada para atualizar a matriz
 
-// Buffer para números de zero a nove.
-const uint32_t numbers[][25] = {
-    // Número 0
-    0, 1, 1, 1, 0, 
-    0, 1, 0, 1, 0, 
-    0, 1, 0, 1, 0, 
-    0, 1, 0, 1, 0, 
-    0, 1, 1, 1, 0,
-    
-    // 1
-    0, 0, 1, 0, 0,
-    0, 0, 1, 0, 0,
-    0, 0, 1, 0, 0,
-    0, 1, 1, 0, 0,
-    0, 0, 1, 0, 0,
-    
-    // 2
-    0, 1, 1, 1, 0,
-    0, 1, 0, 0, 0,
-    0, 0, 1, 0, 0,
-    0, 0, 0, 1, 0,
-    0, 1, 1, 1, 0,
-
-    // 3
-    0, 1, 1, 1, 0,
-    0, 0, 0, 1, 0,
-    0, 1, 1, 1, 0,
-    0, 0, 0, 1, 0,
-    0, 1, 1, 1, 0,
-
-    // 4
-    0, 1, 0, 0, 0,
-    0, 0, 0, 1, 0,
-    0, 1, 1, 1, 0,
-    0, 1, 0, 1, 0,
-    0, 1, 0, 1, 0,
-
-    // 5
-    0, 1, 1, 1, 0,
-    0, 0, 0, 1, 0,
-    0, 1, 1, 1, 0,
-    0, 1, 0, 0, 0,
-    0, 1, 1, 1, 0,
-
-    // 6
-    0, 1, 1, 1, 0,
-    0, 1, 0, 1, 0,
-    0, 1, 1, 1, 0,
-    0, 1, 0, 0, 0,
-    0, 1, 1, 1, 0,
-    
-    // 7
-    0, 0, 0, 1, 0,
-    0, 1, 0, 0, 0,
-    0, 0, 1, 0, 0,
-    0, 0, 0, 1, 0,
-    0, 1, 1, 1, 0,
-
-    // 8
-    0, 1, 1, 1, 0,
-    0, 1, 0, 1, 0,
-    0, 1, 1, 1, 0,
-    0, 1, 0, 1, 0,
-    0, 1, 1, 1, 0,
-
-    // 9
-    0, 1, 1, 1, 0,
-    0, 0, 0, 1, 0,
-    0, 1, 1, 1, 0,
-    0, 1, 0, 1, 0,
-    0, 1, 1, 1, 0,
-
-    // rosto feliz
-    0, 1, 1, 1, 0,
-    1, 0, 0, 0, 1,
-    0, 0, 0, 0, 0,
-    0, 1, 0, 1, 0,
-    0, 1, 0, 1, 0,
-
-    // rosto triste
-    1, 0, 0, 0, 1,
-    0, 1, 1, 1, 0,
-    0, 0, 0, 0, 0,
-    0, 1, 0, 1, 0,
-    0, 1, 0, 1, 0, 
-
-    // rosto normal
-    1, 1, 1, 1, 1,
-    0, 0, 0, 0, 1,
-    0, 0, 0, 0, 0,
-    0, 1, 0, 1, 0,
-    0, 1, 0, 1, 0,
-
-    // simbolo de adição
-    0, 0, 1, 0, 0,
-    0, 0, 1, 0, 0,
-    1, 0, 1, 0, 1,
-    0, 1, 1, 1, 0,
-    0, 0, 1, 0, 0,
-
-    // simbolo de subtração
-    0, 0, 1, 0, 0,
-    0, 1, 1, 1, 0,
-    1, 0, 1, 0, 1,
-    0, 0, 1, 0, 0,
-    0, 0, 1, 0, 0,
-
-    // maçã
-    0, 1, 1, 1, 0,
-    1, 1, 1, 1, 1,
-    1, 1, 1, 1, 1,
-    0, 0, 1, 0, 0,
-    0, 1, 0, 0, 0
-};
-
 /**
  * @brief Transforma a cor RGB em um inteiro de 32 bits sem sinal.
  * 
@@ -138,25 +23,55 @@ static inline uint32_t urgb_u32(uint8_t r, uint8_t g, uint8_t b) {
 }
 
 
+// State machine usada pelas operações de envio
+typedef struct {
+    PIO pio;
+    uint sm;
+} pio_target_t;
+
+static bool pio_fifo_full(void *hw) {
+    pio_target_t *t = hw;
+    return pio_sm_is_tx_fifo_full(t->pio, t->sm);
+}
+
+static void pio_put(void *hw, uint32_t word) {
+    pio_target_t *t = hw;
+    pio_sm_put(t->pio, t->sm, word);
+}
+
+static uint64_t pio_now_us(void *hw) {
+    return time_us_64();
+}
+
+static const matrix_ops_t pio_ops = {
+    .fifo_full = pio_fifo_full,
+    .put = pio_put,
+    .now_us = pio_now_us,
+};
+
+
 /**
- * @brief Atualiza a matriz de LEDs com o número especificado
- * @param current_number Número a ser exibido (0-9)
+ * @brief Atualiza a matriz de LEDs com o ícone especificado
+ * @param current_number Índice do ícone (ICON_*, gerado a partir de assets/icons.txt)
  * 
- * @details Envia os dados para a matriz LED WS2812 usando PIO
+ * @details Envia os dados para a matriz LED WS2812 usando PIO, com tempo
+ * máximo para que uma FIFO travada não bloqueie o laço principal.
+ *
+ * @return false se o ícone não existe ou a FIFO não aceitou os dados a tempo.
  */
-void set_led_matrix(uint8_t current_number, PIO pio, uint sm) {
+bool set_led_matrix(uint8_t current_number, PIO pio, uint sm) {
     // Calcula a cor utilizando a função auxiliar baseada em matrix_rgb
     //uint32_t color = get_number_color(current_number);
     uint32_t color = urgb_u32(20, 2, 10); // Cor rosa
 
-    for (int i = 0; i < 25; i++) {
-        if (numbers[current_number][i]) {
-            pio_sm_put_blocking(pio, sm, color<<8u); // Liga o LED com 1 no buffer
-        } else {
-            pio_sm_put_blocking(pio, sm, 0); // Desliga os LEDs com 0 no buffer
-        }
+    if (current_number >= MATRIX_ICON_COUNT) {
+        return false;
     }
+
+    pio_target_t target = {pio, sm};
+    bool sent = matrix_send(&pio_ops, &target, matrix_icons[current_number], color, MATRIX_TIMEOUT_US);
     sleep_us(50);
+    return sent;
 }
 
 
@@ -165,10 +80,12 @@ void set_led_matrix(uint8_t current_number, PIO pio, uint sm) {
  * 
  * @param pio Instância do PIO utilizada.
  * @param sm Número da state machine.
+ *
+ * @return false se a FIFO não aceitou os dados a tempo.
  */
-void clear_matrix(PIO pio, uint sm) {
-    for (int i = 0; i < 25; i++) {
-        pio_sm_put_blocking(pio, sm, 0);
-    }
+bool clear_matrix(PIO pio, uint sm) {
+    pio_target_t target = {pio, sm};
+    bool sent = matrix_send(&pio_ops, &target, 0, 0, MATRIX_TIMEOUT_US);
     sleep_us(50);
-}
\ No newline at end of file
+    return sent;
+}
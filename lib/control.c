@@ -0,0 +1,184 @@
+#include <stdio.h>
+#include "control.h"
+#include "assets.h"
+
+/**
+ * @brief Inicializa o controle com as leituras iniciais simuladas.
+ *
+ * @param c controle.
+ * @param ops operações de saída e espera.
+ * @param hw contexto repassado às operações.
+ * @param ssd display, já inicializado com ssd1306_init.
+ */
+void control_init(control_t *c, const control_ops_t *ops, void *hw, ssd1306_t *ssd) {
+    *c = (control_t){0};
+    c->ops = ops;
+    c->hw = hw;
+    c->ssd = ssd;
+    c->temperatura = 39;
+    c->umidade = 49;
+    c->oxigenio = 14;
+    c->status = STATUS_NORMAL;
+    c->matrix_ok = true;
+    forecast_reset(&c->forecast);
+}
+
+
+/**
+ * @brief Trata o clique de um botão com debouncing.
+ *
+ * @param c controle.
+ * @param button botão que gerou a interrupção.
+ * @param current_time tempo atual em us.
+ */
+void control_button(control_t *c, button_id_t button, uint32_t current_time) {
+    bool increase;
+
+    if (button >= BUTTON_COUNT || !button_event(&c->buttons[button], current_time, &increase)) {
+        return;
+    }
+
+    switch (button) {
+    case BUTTON_A:
+        update_data(&c->temperatura, increase);
+        break;
+    case BUTTON_B:
+        update_data(&c->umidade, increase);
+        break;
+    default:
+        update_data(&c->oxigenio, increase);
+        break;
+    }
+}
+
+
+/**
+ * @brief Desenha as leituras e a previsão e enfileira o quadro no barramento.
+ *
+ * @return false se não havia espaço na fila do barramento para o quadro.
+ */
+static bool write_display(control_t *c) {
+    ssd1306_t *ssd = c->ssd;
+
+    // Limpa o display
+    ssd1306_fill(ssd, false);
+
+    char msg_temp[20];  // Buffer para armazenar a string formatada
+    sprintf(msg_temp, "Temperatura %d", c->temperatura);
+    ssd1306_draw_string(ssd, msg_temp, 0, 0);
+
+    char msg_umid[20];  // Buffer para armazenar a string formatada
+    sprintf(msg_umid, "Umidade %d", c->umidade);
+    ssd1306_draw_string(ssd, msg_umid, 0, 15);
+
+    char msg_oxig[20];  // Buffer para armazenar a string formatada
+    sprintf(msg_oxig, "Oxigenio %d", c->oxigenio);
+    ssd1306_draw_string(ssd, msg_oxig, 0, 30);
+
+    ssd1306_draw_string(ssd, phase_name(c->forecast.phase), 0, 45);
+
+    if (c->forecast.eta >= 0 && c->forecast.eta <= FORECAST_HORIZON) {
+        char msg_eta[24];  // Buffer para armazenar a string formatada
+        sprintf(msg_eta, "Alarme em %lds", (long)c->forecast.eta); // Uma amostra por ciclo (~1 s)
+        ssd1306_draw_string(ssd, msg_eta, 0, 55);
+    }
+
+    // Atualiza o display
+    return ssd1306_send_data(ssd);
+}
+
+
+static void show_icon(control_t *c, uint8_t icon) {
+    c->matrix_ok = c->ops->show_icon(c->hw, icon);
+    if (!c->matrix_ok) {
+        c->matrix_errors++;
+    }
+}
+
+
+/**
+ * @brief Executa um ciclo do laço principal.
+ *
+ * @param c controle.
+ *
+ * @return o estado calculado neste ciclo.
+ */
+monitor_status_t control_cycle(control_t *c) {
+    readings_t leituras = {c->temperatura, c->umidade, c->oxigenio};
+    forecast_update(&c->forecast, &leituras);
+    monitor_status_t status = apply_forecast(evaluate_status(&leituras), &c->forecast);
+    c->status = status;
+
+    // Se a última escrita falhou, reconfigura o display antes de tentar de novo
+    if (c->ssd->failed) {
+        c->ssd->failed = false;
+        c->display_ok = false;
+        c->i2c_errors++;
+        printf("Falha de I2C no display (%lu)\n", (unsigned long)c->i2c_errors);
+    }
+    if (!c->display_ok) {
+        c->display_ok = ssd1306_config(c->ssd);
+    }
+    if (c->display_ok) {
+        write_display(c);    // Com a fila cheia o quadro é descartado e o próximo ciclo tenta de novo
+    }
+
+    if (status == STATUS_ALARM) {
+        c->ops->set_rgb(c->hw, 1, 0, 0);
+        show_icon(c, ICON_TRISTE);
+
+        c->ops->buzzer(c->hw, true);
+        c->ops->wait_ms(c->hw, ALARM_BEEP_MS);
+        c->ops->buzzer(c->hw, false);
+    }
+    else if (status == STATUS_WARNING) {
+        // Amarelo: a tendência indica que um limite será ultrapassado em breve
+        c->ops->set_rgb(c->hw, 1, 1, 0);
+        show_icon(c, ICON_NORMAL);
+    }
+    else if (status == STATUS_IDEAL) {
+        c->ops->set_rgb(c->hw, 0, 1, 0);
+        show_icon(c, ICON_MACA);
+    }
+    else {
+        c->ops->set_rgb(c->hw, 0, 0, 1);
+        show_icon(c, ICON_MACA);
+    }
+
+    c->ops->wait_ms(c->hw, CYCLE_WAIT_MS);
+    return status;
+}
+
+
+/**
+ * @brief Guarda o estado do controle para um reinício a quente. A tarefa
+ * atrasada e o número de reinícios não são alterados.
+ *
+ * @param c controle.
+ * @param r estado preservado.
+ */
+void control_save(const control_t *c, retained_t *r) {
+    r->leituras = (readings_t){c->temperatura, c->umidade, c->oxigenio};
+    r->forecast = c->forecast;
+    r->status = c->status;
+    r->i2c_errors = c->i2c_errors;
+    r->matrix_errors = c->matrix_errors;
+    retained_seal(r);
+}
+
+
+/**
+ * @brief Retoma o estado guardado por control_save.
+ *
+ * @param c controle, já inicializado com control_init.
+ * @param r estado preservado íntegro.
+ */
+void control_restore(control_t *c, const retained_t *r) {
+    c->temperatura = r->leituras.temperatura;
+    c->umidade = r->leituras.umidade;
+    c->oxigenio = r->leituras.oxigenio;
+    c->forecast = r->forecast;
+    c->status = (monitor_status_t)r->status;
+    c->i2c_errors = r->i2c_errors;
+    c->matrix_errors = r->matrix_errors;
+}
@@ -0,0 +1,63 @@
+#ifndef CONTROL_H
+#define CONTROL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "monitor.h"
+#include "ssd1306.h"
+#include "supervisor.h"
+
+// Um ciclo do laço principal: lê os valores, atualiza a previsão, o display,
+// os LEDs, a matriz e o buzzer. As saídas e a espera são acessadas por uma
+// tabela de operações (control_ops_t), então o laço pode ser reproduzido
+// fora da placa com tempo virtual.
+
+#define CYCLE_WAIT_MS 1000          // Espera no fim de cada ciclo
+#define ALARM_BEEP_MS 500           // Duração do bipe de alarme
+
+typedef enum {
+    BUTTON_A,                       // Altera a temperatura
+    BUTTON_B,                       // Altera a umidade
+    BUTTON_STICK,                   // Altera o oxigênio
+    BUTTON_COUNT
+} button_id_t;
+
+typedef struct {
+    void (*set_rgb)(void *hw, bool r, bool g, bool b);
+    bool (*show_icon)(void *hw, uint8_t icon);      // false se a matriz não aceitou o quadro
+    void (*buzzer)(void *hw, bool on);
+    void (*wait_ms)(void *hw, uint32_t ms);         // Aguarda executando a fila I2C
+} control_ops_t;
+
+typedef struct {
+    const control_ops_t *ops;
+    void *hw;
+    ssd1306_t *ssd;
+    int temperatura;
+    int umidade;
+    int oxigenio;
+    button_t buttons[BUTTON_COUNT];
+    forecast_t forecast;
+    monitor_status_t status;        // Estado calculado no último ciclo
+    bool display_ok;                // Display configurado e respondendo
+    bool matrix_ok;                 // Último quadro da matriz enviado a tempo
+    uint32_t i2c_errors;            // Falhas de comunicação com o display
+    uint32_t matrix_errors;         // Quadros da matriz que não foram enviados
+} control_t;
+
+// Inicializa o controle com as leituras iniciais e o display ainda não configurado.
+void control_init(control_t *c, const control_ops_t *ops, void *hw, ssd1306_t *ssd);
+
+// Trata o clique de um botão (chamada pela interrupção).
+void control_button(control_t *c, button_id_t button, uint32_t current_time);
+
+// Executa um ciclo completo, incluindo a espera final, e retorna o estado calculado.
+monitor_status_t control_cycle(control_t *c);
+
+// Guarda leituras, previsão, estado e contadores no estado preservado.
+void control_save(const control_t *c, retained_t *r);
+
+// Retoma leituras, previsão, estado e contadores após um reinício a quente.
+void control_restore(control_t *c, const retained_t *r);
+
+#endif // CONTROL_H
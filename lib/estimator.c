@@ -0,0 +1,124 @@
+#include "estimator.h"
+
+#define EST_ONE ((int32_t)1 << EST_FRAC_BITS)
+
+/**
+ * @brief Reinicia o estimador, descartando nível e tendência.
+ *
+ * @param e estimador.
+ */
+void estimator_reset(estimator_t *e) {
+    e->level = 0;
+    e->trend = 0;
+    e->last = 0;
+    e->direction = 0;
+    e->moves = 0;
+    e->quiet = 0;
+    e->primed = false;
+}
+
+
+/**
+ * @brief Conta as variações seguidas da leitura no mesmo sentido.
+ */
+static void track_moves(estimator_t *e, int sample) {
+    int delta = sample - e->last;
+    e->last = sample;
+
+    if (delta == 0) {
+        if (e->quiet < EST_GAP) {
+            e->quiet++;
+        }
+        if (e->quiet == EST_GAP) {
+            e->moves = 0;
+        }
+        return;
+    }
+
+    int8_t direction = delta > 0 ? 1 : -1;
+    if (direction != e->direction) {
+        e->direction = direction;
+        e->moves = 0;
+    }
+    if (e->moves < UINT8_MAX) {
+        e->moves++;
+    }
+    e->quiet = 0;
+}
+
+
+/**
+ * @brief Incorpora uma amostra: prevê o próximo nível pela tendência e
+ * corrige nível e tendência por frações do resíduo.
+ *
+ * @param e estimador.
+ * @param sample nova leitura.
+ */
+void estimator_update(estimator_t *e, int sample) {
+    int32_t measured = (int32_t)sample * EST_ONE;
+
+    if (!e->primed) {
+        e->level = measured;
+        e->trend = 0;
+        e->last = sample;
+        e->primed = true;
+        return;
+    }
+
+    track_moves(e, sample);
+
+    int32_t predicted = e->level + e->trend;
+    int32_t residual = measured - predicted;
+
+    e->level = predicted + (residual >> EST_ALPHA_SHIFT);
+    e->trend += residual >> EST_BETA_SHIFT;
+}
+
+
+/**
+ * @brief Retorna o nível filtrado arredondado para inteiro.
+ *
+ * @param e estimador.
+ */
+int estimator_level(const estimator_t *e) {
+    return (int)((e->level + EST_ONE / 2) >> EST_FRAC_BITS);
+}
+
+
+/**
+ * @brief Estima quantas amostras faltam para o nível atingir o limite.
+ *
+ * @param e estimador.
+ * @param limit limite a ser atingido.
+ * @param above true se o alarme ocorre no limite ou acima dele, false se
+ * ocorre no limite ou abaixo dele.
+ *
+ * @return número de amostras (0 se o nível e a leitura já estão no limite ou
+ * além dele) ou -1 se não há tendência confirmada em direção ao limite.
+ */
+int32_t estimator_samples_to(const estimator_t *e, int limit, bool above) {
+    if (!e->primed) {
+        return -1;
+    }
+
+    int32_t distance = (int32_t)limit * EST_ONE - e->level;
+
+    int8_t toward = above ? 1 : -1;
+
+    if (above ? distance <= 0 : distance >= 0) {
+        // O nível filtrado demora a voltar depois que a leitura sai do limite;
+        // se ela já voltou ou está se afastando dele, ou se a tendência se
+        // afasta, não há previsão
+        bool back = above ? e->last < limit : e->last > limit;
+        bool leaving = e->moves > 0 && e->direction != toward;
+        bool away = above ? e->trend < 0 : e->trend > 0;
+        return back || leaving || away ? -1 : 0;
+    }
+    // Só segue a tendência se a leitura também está se movendo em direção ao limite
+    if ((above ? e->trend <= 0 : e->trend >= 0) || e->moves < EST_SUSTAIN || e->direction != toward) {
+        return -1;
+    }
+
+    // Arredonda para cima: o limite só é cruzado após a última amostra inteira
+    return (distance + e->trend - (e->trend > 0 ? 1 : -1)) / e->trend;
+}
@@ -0,0 +1,47 @@
+#ifndef ESTIMATOR_H
+#define ESTIMATOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Estimador incremental de nível e tendência (filtro alfa-beta) em ponto fixo.
+// Cada atualização custa O(1), usa apenas somas e deslocamentos e ocupa
+// memória constante, podendo rodar a cada amostra no laço principal.
+//
+// Um degrau na leitura também gera tendência no filtro, que só se desfaz
+// depois de várias amostras. Por isso a tendência só é usada na previsão
+// quando a própria leitura confirma o movimento: EST_SUSTAIN variações
+// seguidas no mesmo sentido, sem intervalos maiores que EST_GAP amostras.
+
+#define EST_FRAC_BITS   16          // Bits fracionários (formato Q16.16)
+#define EST_ALPHA_SHIFT 2           // Ganho do nível: alfa = 1/4
+#define EST_BETA_SHIFT  5           // Ganho da tendência: beta = 1/32 (próximo do amortecimento crítico)
+#define EST_SUSTAIN     2           // Variações seguidas da leitura que confirmam a tendência
+#define EST_GAP         16          // Amostras sem variação que encerram a sequência
+
+typedef struct {
+    int32_t level;                  // Nível filtrado (Q16.16)
+    int32_t trend;                  // Variação por amostra (Q16.16)
+    int last;                       // Última amostra
+    int8_t direction;               // Sentido das últimas variações da leitura (-1 ou 1)
+    uint8_t moves;                  // Variações seguidas nesse sentido
+    uint8_t quiet;                  // Amostras desde a última variação
+    bool primed;                    // Indica se já recebeu a primeira amostra
+} estimator_t;
+
+// Reinicia o estimador.
+void estimator_reset(estimator_t *e);
+
+// Incorpora uma nova amostra.
+void estimator_update(estimator_t *e, int sample);
+
+// Retorna o nível filtrado arredondado para inteiro.
+int estimator_level(const estimator_t *e);
+
+// Retorna em quantas amostras o nível deve atingir o limite, seguindo a
+// tendência atual: 0 se o nível e a leitura já estão no limite ou além dele
+// (acima se above, abaixo caso contrário) e -1 se não há tendência confirmada
+// em direção a ele, inclusive quando a leitura já voltou do limite.
+int32_t estimator_samples_to(const estimator_t *e, int limit, bool above);
+
+#endif // ESTIMATOR_H
@@ -0,0 +1,32 @@
+#include "font.h"
+
+/**
+ * @brief Busca o glifo do caractere pela tabela indexada por ASCII.
+ *
+ * @param c caractere.
+ * @param scratch buffer de FONT_WIDTH bytes, usado apenas com FONT_RLE.
+ *
+ * @return ponteiro para as FONT_WIDTH colunas do glifo.
+ */
+const uint8_t *font_glyph(char c, uint8_t *scratch) {
+    uint8_t code = (uint8_t)c;
+    uint8_t glyph = code < 128 ? font_index[code] : 0;  // Glifo 0 é o caractere padrão
+
+#if FONT_RLE
+    // Pares (repetições, valor) até completar a largura do glifo
+    const uint8_t *src = &font_data[font_offsets[glyph]];
+    uint8_t filled = 0;
+
+    while (filled < FONT_WIDTH) {
+        uint8_t run = *src++;
+        uint8_t value = *src++;
+        while (run-- && filled < FONT_WIDTH) {
+            scratch[filled++] = value;
+        }
+    }
+    return scratch;
+#else
+    (void)scratch;
+    return &font_data[glyph * FONT_WIDTH];
+#endif
+}
@@ -0,0 +1,315 @@
+#include <string.h>
+#include "i2c_bus.h"
+
+/**
+ * @brief Inicializa o gerenciador do barramento com a fila vazia.
+ *
+ * @param bus gerenciador.
+ * @param ops operações de acesso ao hardware.
+ * @param hw contexto repassado às operações.
+ */
+void i2c_bus_init(i2c_bus_t *bus, const i2c_bus_ops_t *ops, void *hw) {
+    memset(bus, 0, sizeof(*bus));
+    bus->ops = ops;
+    bus->hw = hw;
+    bus->stats.window_start_us = ops->now_us(hw);
+}
+
+
+/**
+ * @brief Reserva uma posição livre na fila.
+ *
+ * @return a transação reservada ou NULL se a fila estiver cheia ou os
+ * dados não couberem.
+ */
+static i2c_txn_t *reserve(i2c_bus_t *bus, uint8_t address, i2c_priority_t priority, size_t tx_len,
+                          i2c_bus_callback_t done, void *ctx) {
+    if (tx_len > I2C_BUS_MAX_DATA || bus->count == I2C_BUS_QUEUE_LEN) {
+        bus->stats.rejected++;
+        return NULL;
+    }
+
+    for (size_t i = 0; i < I2C_BUS_QUEUE_LEN; ++i) {
+        i2c_txn_t *txn = &bus->queue[i];
+        if (txn->used)
+            continue;
+
+        txn->used = true;
+        txn->address = address;
+        txn->priority = priority;
+        txn->attempts = 0;
+        txn->max_attempts = I2C_BUS_MAX_ATTEMPTS;
+        txn->seq = bus->next_seq++;
+        txn->tx_len = tx_len;
+        txn->rx = NULL;
+        txn->rx_len = 0;
+        txn->done = done;
+        txn->ctx = ctx;
+        bus->count++;
+        bus->stats.submitted++;
+        return txn;
+    }
+    return NULL;
+}
+
+
+/**
+ * @brief Enfileira uma escrita.
+ *
+ * @return false se a fila estiver cheia ou os dados forem grandes demais.
+ */
+bool i2c_bus_write(i2c_bus_t *bus, uint8_t address, i2c_priority_t priority,
+                   const uint8_t *src, size_t len, i2c_bus_callback_t done, void *ctx) {
+    i2c_txn_t *txn = reserve(bus, address, priority, len, done, ctx);
+    if (!txn)
+        return false;
+
+    memcpy(txn->tx, src, len);
+    return true;
+}
+
+
+/**
+ * @brief Reserva uma transação com o prefixo seguido dos dados.
+ *
+ * @return a transação reservada ou NULL se não couber na fila.
+ */
+static i2c_txn_t *reserve_prefixed(i2c_bus_t *bus, uint8_t address, i2c_priority_t priority, uint8_t prefix,
+                                   const uint8_t *src, size_t len, i2c_bus_callback_t done, void *ctx) {
+    i2c_txn_t *txn = reserve(bus, address, priority, len + 1, done, ctx);
+    if (!txn)
+        return NULL;
+
+    txn->tx[0] = prefix;
+    memcpy(&txn->tx[1], src, len);
+    return txn;
+}
+
+
+/**
+ * @brief Enfileira a escrita de um byte de prefixo seguido dos dados.
+ *
+ * Usado pelo display, que exige um byte de controle antes de cada bloco
+ * de dados. Os dados são copiados, então o buffer de origem pode ser
+ * alterado logo após a chamada.
+ *
+ * @return false se a fila estiver cheia ou os dados forem grandes demais.
+ */
+bool i2c_bus_write_prefixed(i2c_bus_t *bus, uint8_t address, i2c_priority_t priority, uint8_t prefix,
+                            const uint8_t *src, size_t len, i2c_bus_callback_t done, void *ctx) {
+    return reserve_prefixed(bus, address, priority, prefix, src, len, done, ctx) != NULL;
+}
+
+
+/**
+ * @brief Enfileira um prefixo seguido dos dados, sem repetir em caso de falha.
+ *
+ * Uma transferência que falha no meio já pode ter avançado o ponteiro de
+ * escrita do periférico; repeti-la gravaria os dados deslocados. A falha
+ * vai direto para o callback, que decide como recuperar.
+ *
+ * @return false se a fila estiver cheia ou os dados forem grandes demais.
+ */
+bool i2c_bus_write_prefixed_once(i2c_bus_t *bus, uint8_t address, i2c_priority_t priority, uint8_t prefix,
+                                 const uint8_t *src, size_t len, i2c_bus_callback_t done, void *ctx) {
+    i2c_txn_t *txn = reserve_prefixed(bus, address, priority, prefix, src, len, done, ctx);
+    if (!txn)
+        return false;
+
+    txn->max_attempts = 1;
+    return true;
+}
+
+
+/**
+ * @brief Enfileira uma escrita seguida de leitura com repeated start.
+ *
+ * @param dst destino da leitura; deve permanecer válido até o callback.
+ *
+ * @return false se a fila estiver cheia ou os dados forem grandes demais.
+ */
+bool i2c_bus_read(i2c_bus_t *bus, uint8_t address, i2c_priority_t priority,
+                  const uint8_t *src, size_t src_len, uint8_t *dst, size_t len,
+                  i2c_bus_callback_t done, void *ctx) {
+    i2c_txn_t *txn = reserve(bus, address, priority, src_len, done, ctx);
+    if (!txn)
+        return false;
+
+    memcpy(txn->tx, src, src_len);
+    txn->rx = dst;
+    txn->rx_len = len;
+    return true;
+}
+
+
+/**
+ * @brief Retorna quantas transações ainda cabem na fila.
+ */
+size_t i2c_bus_free(const i2c_bus_t *bus) {
+    return I2C_BUS_QUEUE_LEN - bus->count;
+}
+
+
+/**
+ * @brief Remove da fila as transações pendentes de um periférico.
+ *
+ * Usado quando uma transação falha e as seguintes do mesmo periférico
+ * dependem dela (ex.: blocos restantes de um quadro do display). Pode
+ * ser chamada de dentro de um callback.
+ *
+ * @param ctx contexto informado ao enfileirar as transações.
+ *
+ * @return número de transações removidas.
+ */
+size_t i2c_bus_cancel(i2c_bus_t *bus, void *ctx) {
+    size_t cancelled = 0;
+
+    for (size_t i = 0; i < I2C_BUS_QUEUE_LEN; ++i) {
+        i2c_txn_t *txn = &bus->queue[i];
+        if (!txn->used || txn->ctx != ctx)
+            continue;
+
+        txn->used = false;
+        bus->count--;
+        cancelled++;
+    }
+    bus->stats.cancelled += cancelled;
+    return cancelled;
+}
+
+
+/**
+ * @brief Seleciona a transação de maior prioridade e, entre as de mesma
+ * prioridade, a mais antiga.
+ */
+static i2c_txn_t *next_txn(i2c_bus_t *bus) {
+    i2c_txn_t *best = NULL;
+
+    for (size_t i = 0; i < I2C_BUS_QUEUE_LEN; ++i) {
+        i2c_txn_t *txn = &bus->queue[i];
+        if (!txn->used)
+            continue;
+        // Subtração sem sinal mantém a ordem mesmo quando seq dá a volta
+        if (!best || txn->priority < best->priority ||
+            (txn->priority == best->priority && (int32_t)(txn->seq - best->seq) < 0))
+            best = txn;
+    }
+    return best;
+}
+
+
+static uint32_t timeout_for(size_t len) {
+    return I2C_BUS_TIMEOUT_BASE_US + len * I2C_BUS_TIMEOUT_PER_BYTE_US;
+}
+
+
+/**
+ * @brief Executa a transação no hardware.
+ *
+ * @return número de bytes transferidos ou valor negativo em caso de falha.
+ */
+static int execute(i2c_bus_t *bus, const i2c_txn_t *txn) {
+    bool has_read = txn->rx && txn->rx_len;
+    int result = txn->tx_len;
+
+    if (txn->tx_len) {
+        result = bus->ops->write(bus->hw, txn->address, txn->tx, txn->tx_len, has_read, timeout_for(txn->tx_len));
+        if (result != (int)txn->tx_len)
+            return result < 0 ? result : -1;
+    }
+
+    if (has_read) {
+        result = bus->ops->read(bus->hw, txn->address, txn->rx, txn->rx_len, timeout_for(txn->rx_len));
+        if (result != (int)txn->rx_len)
+            return result < 0 ? result : -1;
+    }
+    return result;
+}
+
+
+static void finish(i2c_bus_t *bus, i2c_txn_t *txn, int result) {
+    i2c_bus_callback_t done = txn->done;
+    void *ctx = txn->ctx;
+
+    // Libera a posição antes do callback, que pode enfileirar outra transação
+    txn->used = false;
+    bus->count--;
+
+    if (done)
+        done(result, ctx);
+}
+
+
+/**
+ * @brief Executa a transação pendente de maior prioridade.
+ *
+ * Falhas são repetidas até max_attempts vezes (I2C_BUS_MAX_ATTEMPTS,
+ * salvo transações enfileiradas com uma única tentativa). Após
+ * I2C_BUS_RESET_ERRORS falhas seguidas o barramento é recuperado antes
+ * da próxima tentativa.
+ *
+ * @return false se não havia transação pendente.
+ */
+bool i2c_bus_process(i2c_bus_t *bus) {
+    i2c_txn_t *txn = next_txn(bus);
+    if (!txn)
+        return false;
+
+    uint64_t start = bus->ops->now_us(bus->hw);
+    int result = execute(bus, txn);
+    bus->stats.busy_us += bus->ops->now_us(bus->hw) - start;
+
+    if (result >= 0) {
+        bus->consecutive_errors = 0;
+        bus->stats.completed++;
+        finish(bus, txn, result);
+        return true;
+    }
+
+    bus->stats.errors++;
+    if (++bus->consecutive_errors >= I2C_BUS_RESET_ERRORS) {
+        i2c_bus_recover(bus);
+    }
+
+    if (++txn->attempts >= txn->max_attempts) {
+        bus->stats.failed++;
+        finish(bus, txn, result);
+    }
+    return true;
+}
+
+
+/**
+ * @brief Libera o barramento e reinicia o controlador.
+ */
+void i2c_bus_recover(i2c_bus_t *bus) {
+    bus->ops->reset(bus->hw);
+    bus->stats.resets++;
+    bus->consecutive_errors = 0;
+}
+
+
+/**
+ * @brief Executa transações até esvaziar a fila.
+ */
+void i2c_bus_flush(i2c_bus_t *bus) {
+    while (i2c_bus_process(bus))
+        ;
+}
+
+
+/**
+ * @brief Calcula a ocupação do barramento desde o início da janela e
+ * inicia uma nova janela de medição.
+ *
+ * @return ocupação em porcentagem.
+ */
+uint32_t i2c_bus_utilization(i2c_bus_t *bus) {
+    uint64_t now = bus->ops->now_us(bus->hw);
+    uint64_t window = now - bus->stats.window_start_us;
+    uint32_t pct = window ? (uint32_t)((bus->stats.busy_us * 100) / window) : 0;
+
+    bus->stats.busy_us = 0;
+    bus->stats.window_start_us = now;
+    return pct;
+}
@@ -0,0 +1,121 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Gerenciador do barramento I2C compartilhado. Os periféricos não acessam
+// a porta diretamente: enfileiram transações com prioridade e o laço
+// principal as executa uma por vez com i2c_bus_process(). O acesso ao
+// hardware é feito por uma tabela de operações (i2c_bus_ops_t), então a
+// fila pode ser exercitada fora da placa com um barramento simulado.
+
+#define I2C_BUS_QUEUE_LEN     16    // Transações pendentes no máximo
+#define I2C_BUS_MAX_DATA      129   // Um bloco de dados do display (128 bytes) + byte de controle
+#define I2C_BUS_MAX_ATTEMPTS  2     // Tentativas por transação antes de descartá-la
+#define I2C_BUS_RESET_ERRORS  2     // Falhas seguidas que disparam a recuperação do barramento
+
+// Tempo máximo de uma transferência: base fixa mais um limite por byte
+// (a 400 kHz cada byte leva ~23 us), para que um periférico travado
+// não bloqueie o laço principal.
+#define I2C_BUS_TIMEOUT_BASE_US     1000
+#define I2C_BUS_TIMEOUT_PER_BYTE_US 50
+
+// Prioridade das transações. Valores menores são executados primeiro.
+typedef enum {
+    I2C_PRIO_SENSOR = 0,            // Leituras de sensores
+    I2C_PRIO_DISPLAY = 1            // Comandos e dados do display
+} i2c_priority_t;
+
+// Chamada ao fim da transação com o número de bytes transferidos ou um
+// valor negativo em caso de falha.
+typedef void (*i2c_bus_callback_t)(int result, void *ctx);
+
+// Acesso ao hardware. Retornos seguem o SDK: bytes transferidos ou erro negativo.
+typedef struct {
+    int (*write)(void *hw, uint8_t address, const uint8_t *src, size_t len, bool nostop, uint32_t timeout_us);
+    int (*read)(void *hw, uint8_t address, uint8_t *dst, size_t len, uint32_t timeout_us);
+    void (*reset)(void *hw);        // Libera o barramento e reinicia o controlador
+    uint64_t (*now_us)(void *hw);
+} i2c_bus_ops_t;
+
+typedef struct {
+    bool used;
+    uint8_t address;
+    uint8_t priority;
+    uint8_t attempts;
+    uint8_t max_attempts;           // I2C_BUS_MAX_ATTEMPTS, ou 1 se a transação não pode ser repetida
+    uint32_t seq;                   // Ordem de chegada, para manter FIFO dentro da prioridade
+    size_t tx_len;
+    uint8_t tx[I2C_BUS_MAX_DATA];
+    uint8_t *rx;                    // Destino da leitura (NULL para apenas escrita)
+    size_t rx_len;
+    i2c_bus_callback_t done;
+    void *ctx;
+} i2c_txn_t;
+
+// Métricas de uso do barramento.
+typedef struct {
+    uint32_t submitted;             // Transações aceitas na fila
+    uint32_t completed;             // Transações concluídas com sucesso
+    uint32_t failed;                // Transações descartadas após esgotar as tentativas
+    uint32_t rejected;              // Transações recusadas por fila cheia
+    uint32_t cancelled;             // Transações removidas da fila antes de executar
+    uint32_t errors;                // Tentativas que falharam
+    uint32_t resets;                // Recuperações do barramento
+    uint64_t busy_us;               // Tempo ocupado desde window_start_us
+    uint64_t window_start_us;       // Início da janela de medição
+} i2c_bus_stats_t;
+
+typedef struct {
+    const i2c_bus_ops_t *ops;
+    void *hw;
+    i2c_txn_t queue[I2C_BUS_QUEUE_LEN];
+    uint8_t count;
+    uint32_t next_seq;
+    uint8_t consecutive_errors;
+    i2c_bus_stats_t stats;
+} i2c_bus_t;
+
+// Inicializa o gerenciador com a tabela de operações do hardware.
+void i2c_bus_init(i2c_bus_t *bus, const i2c_bus_ops_t *ops, void *hw);
+
+// Enfileira uma escrita. Retorna false se a fila estiver cheia ou os dados forem grandes demais.
+bool i2c_bus_write(i2c_bus_t *bus, uint8_t address, i2c_priority_t priority,
+                   const uint8_t *src, size_t len, i2c_bus_callback_t done, void *ctx);
+
+// Enfileira a escrita de um prefixo (ex.: byte de controle) seguido dos dados.
+bool i2c_bus_write_prefixed(i2c_bus_t *bus, uint8_t address, i2c_priority_t priority, uint8_t prefix,
+                            const uint8_t *src, size_t len, i2c_bus_callback_t done, void *ctx);
+
+// Igual a i2c_bus_write_prefixed, mas com uma única tentativa: para dados
+// que avançam um ponteiro no periférico e não podem ser reenviados.
+bool i2c_bus_write_prefixed_once(i2c_bus_t *bus, uint8_t address, i2c_priority_t priority, uint8_t prefix,
+                                 const uint8_t *src, size_t len, i2c_bus_callback_t done, void *ctx);
+
+// Enfileira a escrita de src (ex.: registrador) seguida da leitura de len bytes em dst.
+bool i2c_bus_read(i2c_bus_t *bus, uint8_t address, i2c_priority_t priority,
+                  const uint8_t *src, size_t src_len, uint8_t *dst, size_t len,
+                  i2c_bus_callback_t done, void *ctx);
+
+// Retorna quantas transações ainda cabem na fila.
+size_t i2c_bus_free(const i2c_bus_t *bus);
+
+// Remove da fila as transações pendentes enfileiradas com ctx, sem chamar
+// o callback. Retorna quantas foram removidas.
+size_t i2c_bus_cancel(i2c_bus_t *bus, void *ctx);
+
+// Executa a transação pendente de maior prioridade. Retorna false se a fila estava vazia.
+bool i2c_bus_process(i2c_bus_t *bus);
+
+// Recupera o barramento imediatamente (ex.: após um reinício no meio de uma transferência).
+void i2c_bus_recover(i2c_bus_t *bus);
+
+// Executa transações até esvaziar a fila.
+void i2c_bus_flush(i2c_bus_t *bus);
+
+// Retorna a ocupação do barramento (%) desde o início da janela e inicia uma nova janela.
+uint32_t i2c_bus_utilization(i2c_bus_t *bus);
+
+#endif // I2C_BUS_H
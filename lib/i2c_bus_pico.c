@@ -0,0 +1,80 @@
+#include "i2c_bus_pico.h"
+
+static int pico_write(void *hw, uint8_t address, const uint8_t *src, size_t len, bool nostop, uint32_t timeout_us) {
+    i2c_bus_pico_t *pico = hw;
+    return i2c_write_timeout_us(pico->port, address, src, len, nostop, timeout_us);
+}
+
+static int pico_read(void *hw, uint8_t address, uint8_t *dst, size_t len, uint32_t timeout_us) {
+    i2c_bus_pico_t *pico = hw;
+    return i2c_read_timeout_us(pico->port, address, dst, len, false, timeout_us);
+}
+
+static void setup_pins(i2c_bus_pico_t *pico) {
+    i2c_init(pico->port, pico->baudrate);
+    gpio_set_function(pico->sda, GPIO_FUNC_I2C);                  // Set the GPIO pin function to I2C
+    gpio_set_function(pico->scl, GPIO_FUNC_I2C);                  // Set the GPIO pin function to I2C
+    gpio_pull_up(pico->sda);                                      // Pull up the data line
+    gpio_pull_up(pico->scl);                                      // Pull up the clock line
+}
+
+/**
+ * @brief Recupera o barramento: gera até 9 pulsos de clock para que um
+ * periférico preso no meio de um byte libere SDA, envia um STOP e
+ * reinicia o controlador.
+ */
+static void pico_reset(void *hw) {
+    i2c_bus_pico_t *pico = hw;
+
+    i2c_deinit(pico->port);
+    gpio_init(pico->sda);
+    gpio_init(pico->scl);
+    gpio_pull_up(pico->sda);
+    gpio_pull_up(pico->scl);
+    gpio_set_dir(pico->sda, GPIO_IN);
+    gpio_put(pico->scl, 1);
+    gpio_set_dir(pico->scl, GPIO_OUT);
+
+    for (int i = 0; i < 9 && !gpio_get(pico->sda); ++i) {
+        gpio_put(pico->scl, 0);
+        sleep_us(5);
+        gpio_put(pico->scl, 1);
+        sleep_us(5);
+    }
+
+    // STOP: SDA sobe enquanto SCL está alto
+    gpio_put(pico->scl, 0);
+    sleep_us(5);
+    gpio_put(pico->sda, 0);
+    gpio_set_dir(pico->sda, GPIO_OUT);
+    sleep_us(5);
+    gpio_put(pico->scl, 1);
+    sleep_us(5);
+    gpio_set_dir(pico->sda, GPIO_IN);
+    sleep_us(5);
+
+    setup_pins(pico);
+}
+
+static uint64_t pico_now_us(void *hw) {
+    return time_us_64();
+}
+
+static const i2c_bus_ops_t pico_ops = {
+    .write = pico_write,
+    .read = pico_read,
+    .reset = pico_reset,
+    .now_us = pico_now_us,
+};
+
+
+/**
+ * @brief Configura a porta I2C e os pinos e inicializa o gerenciador.
+ *
+ * @param bus gerenciador do barramento.
+ * @param hw porta e pinos; deve permanecer válido enquanto o gerenciador for usado.
+ */
+void i2c_bus_pico_init(i2c_bus_t *bus, i2c_bus_pico_t *hw) {
+    setup_pins(hw);
+    i2c_bus_init(bus, &pico_ops, hw);
+}
@@ -0,0 +1,19 @@
+#ifndef I2C_BUS_PICO_H
+#define I2C_BUS_PICO_H
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "i2c_bus.h"
+
+// Porta I2C do RP2040 usada pelo gerenciador do barramento.
+typedef struct {
+    i2c_inst_t *port;
+    uint sda;
+    uint scl;
+    uint baudrate;
+} i2c_bus_pico_t;
+
+// Configura a porta e os pinos e inicializa o gerenciador sobre ela.
+void i2c_bus_pico_init(i2c_bus_t *bus, i2c_bus_pico_t *hw);
+
+#endif // I2C_BUS_PICO_H
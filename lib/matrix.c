@@ -0,0 +1,26 @@
+#include "matrix.h"
+
+/**
+ * @brief Envia um quadro para a matriz sem bloquear indefinidamente.
+ *
+ * @param ops operações de acesso à FIFO.
+ * @param hw contexto repassado às operações.
+ * @param icon máscara do ícone (bit i = LED i aceso).
+ * @param color cor dos LEDs acesos (GRB nos 24 bits menos significativos).
+ * @param timeout_us tempo máximo para enviar o quadro inteiro.
+ *
+ * @return false se a FIFO ficou cheia além do tempo máximo.
+ */
+bool matrix_send(const matrix_ops_t *ops, void *hw, uint32_t icon, uint32_t color, uint32_t timeout_us) {
+    uint64_t start = ops->now_us(hw);
+
+    for (int i = 0; i < MATRIX_LEDS; i++) {
+        while (ops->fifo_full(hw)) {
+            if (ops->now_us(hw) - start > timeout_us) {
+                return false;
+            }
+        }
+        ops->put(hw, (icon & (1u << i)) ? color << 8u : 0);
+    }
+    return true;
+}
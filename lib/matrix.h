@@ -0,0 +1,25 @@
+#ifndef MATRIX_H
+#define MATRIX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Envio de um quadro para a matriz de LEDs WS2812. O acesso à FIFO da PIO
+// é feito por uma tabela de operações (matrix_ops_t), então o envio pode
+// ser exercitado fora da placa, inclusive com a FIFO travada.
+
+#define MATRIX_LEDS       25
+#define MATRIX_TIMEOUT_US 5000      // Um quadro leva ~750 us (25 LEDs x 24 bits a 800 kHz)
+
+typedef struct {
+    bool (*fifo_full)(void *hw);
+    void (*put)(void *hw, uint32_t word);
+    uint64_t (*now_us)(void *hw);
+} matrix_ops_t;
+
+// Envia o ícone (bit i = LED i aceso) com a cor informada. Retorna false se
+// a FIFO não aceitou os dados dentro de timeout_us; o quadro fica incompleto
+// e é reenviado inteiro na próxima atualização.
+bool matrix_send(const matrix_ops_t *ops, void *hw, uint32_t icon, uint32_t color, uint32_t timeout_us);
+
+#endif // MATRIX_H
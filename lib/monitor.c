@@ -0,0 +1,141 @@
+#include "monitor.h"
+
+/**
+ * @brief Aplica o debounce a um clique do botão.
+ *
+ * @param btn estado de debounce do botão.
+ * @param current_time tempo atual em us.
+ * @param increase recebe true se o clique deve incrementar o valor.
+ *
+ * @return true se o clique foi aceito.
+ */
+bool button_event(button_t *btn, uint32_t current_time, bool *increase) {
+    uint32_t elapsed = current_time - btn->last_time;
+
+    if (elapsed <= DEBOUNCE_TIME) {
+        return false;
+    }
+
+    *increase = elapsed > WAIT_TIME;  // Se o tempo entre cliques for grande, aumenta, senão, diminui
+    btn->last_time = current_time;
+    return true;
+}
+
+
+/**
+ * @brief Simula a alteração de valores dos sensores.
+ *
+ * @param data variável que irá ser alterada.
+ * @param increase booleano que informa se é incremento ou decremento de valor.
+ */
+void update_data(int *data, bool increase) {
+    if (increase) {
+        *data += 5;
+    } else {
+        *data -= 5;
+    }
+}
+
+
+/**
+ * @brief Classifica as leituras dos sensores.
+ *
+ * @param r leituras atuais.
+ *
+ * @return STATUS_ALARM, STATUS_IDEAL ou STATUS_NORMAL.
+ */
+monitor_status_t evaluate_status(const readings_t *r) {
+    if ((r->temperatura > TEMP_MAX) || (r->umidade > UMID_MAX) || (r->oxigenio < OXIG_MIN)) {
+        return STATUS_ALARM;
+    }
+    if ((40 < r->temperatura && r->temperatura < TEMP_MAX) && (50 < r->umidade && r->umidade < UMID_MAX) && (r->oxigenio > OXIG_MIN)) {
+        return STATUS_IDEAL;
+    }
+    return STATUS_NORMAL;
+}
+
+
+/**
+ * @brief Reinicia a previsão, descartando o histórico.
+ *
+ * @param f previsão.
+ */
+void forecast_reset(forecast_t *f) {
+    estimator_reset(&f->temperatura);
+    estimator_reset(&f->umidade);
+    estimator_reset(&f->oxigenio);
+    f->phase = PHASE_MESOPHILIC;
+    f->eta = -1;
+}
+
+
+/**
+ * @brief Retorna o menor tempo até o alarme entre dois candidatos (-1 = nenhum).
+ */
+static int32_t earliest(int32_t a, int32_t b) {
+    if (a < 0) return b;
+    if (b < 0) return a;
+    return a < b ? a : b;
+}
+
+
+/**
+ * @brief Incorpora uma amostra das leituras, atualizando a fase da
+ * compostagem e o tempo previsto até o próximo alarme.
+ *
+ * @param f previsão.
+ * @param r leituras atuais.
+ */
+void forecast_update(forecast_t *f, const readings_t *r) {
+    estimator_update(&f->temperatura, r->temperatura);
+    estimator_update(&f->umidade, r->umidade);
+    estimator_update(&f->oxigenio, r->oxigenio);
+
+    // A fase segue a leitura e não o nível filtrado, que ultrapassa o valor
+    // lido logo após um degrau. A histerese entre THERMO_ENTER e THERMO_EXIT
+    // evita alternar de fase com ruído.
+    int temp = r->temperatura;
+    if (temp >= THERMO_ENTER) {
+        f->phase = PHASE_THERMOPHILIC;
+    } else if (f->phase == PHASE_THERMOPHILIC && temp < THERMO_EXIT) {
+        f->phase = PHASE_COOLING;
+    }
+
+    // Os limites de alarme são estritos, então o alarme ocorre ao passar de um valor além deles
+    int32_t eta = estimator_samples_to(&f->temperatura, TEMP_MAX + 1, true);
+    eta = earliest(eta, estimator_samples_to(&f->umidade, UMID_MAX + 1, true));
+    eta = earliest(eta, estimator_samples_to(&f->oxigenio, OXIG_MIN - 1, false));
+    f->eta = eta;
+}
+
+
+/**
+ * @brief Promove o estado para STATUS_WARNING quando a previsão indica
+ * alarme dentro de FORECAST_HORIZON amostras.
+ *
+ * @param status estado calculado pelas leituras atuais.
+ * @param f previsão.
+ */
+monitor_status_t apply_forecast(monitor_status_t status, const forecast_t *f) {
+    if (status != STATUS_ALARM && f->eta >= 0 && f->eta <= FORECAST_HORIZON) {
+        return STATUS_WARNING;
+    }
+    return status;
+}
+
+
+/**
+ * @brief Retorna o nome da fase para exibição no display.
+ *
+ * @param phase fase da compostagem.
+ */
+const char *phase_name(compost_phase_t phase) {
+    switch (phase) {
+    case PHASE_THERMOPHILIC:
+        return "Termofilica";
+    case PHASE_COOLING:
+        return "Resfriamento";
+    default:
+        return "Mesofilica";
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef MONITOR_H
+#define MONITOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "estimator.h"
+
+// Lógica de controle da composteira, sem dependência de hardware.
+// Todas as funções recebem o tempo atual como parâmetro, o que permite
+// executá-las com tempo virtual fora da placa.
+
+#define DEBOUNCE_TIME 200000        // Tempo para debounce em us
+#define WAIT_TIME     1000000       // Intervalo (us) acima do qual o clique incrementa
+
+#define TEMP_MAX    60              // Temperatura máxima (°C) antes do alarme
+#define UMID_MAX    70              // Umidade máxima (%) antes do alarme
+#define OXIG_MIN    15              // Oxigênio mínimo (%) antes do alarme
+
+#define THERMO_ENTER 45             // Temperatura (°C) de entrada na fase termofílica
+#define THERMO_EXIT  43             // Temperatura (°C) de saída da fase termofílica
+
+#define FORECAST_HORIZON 30         // Antecedência (amostras) do aviso de alarme
+
+// Estado do sistema de acordo com as leituras.
+typedef enum {
+    STATUS_NORMAL,                  // Fora da faixa ideal, mas sem alarme
+    STATUS_IDEAL,                   // Todas as leituras na faixa ideal
+    STATUS_WARNING,                 // Tendência indica alarme em breve
+    STATUS_ALARM                    // Algum limite foi ultrapassado
+} monitor_status_t;
+
+// Leituras dos sensores.
+typedef struct {
+    int temperatura;
+    int umidade;
+    int oxigenio;
+} readings_t;
+
+// Fase da compostagem, definida pela temperatura lida.
+typedef enum {
+    PHASE_MESOPHILIC,               // Aquecimento inicial, abaixo de THERMO_ENTER
+    PHASE_THERMOPHILIC,             // Decomposição ativa em alta temperatura
+    PHASE_COOLING                   // Resfriamento após a fase termofílica
+} compost_phase_t;
+
+// Previsão incremental das leituras, atualizada a cada amostra.
+typedef struct {
+    estimator_t temperatura;
+    estimator_t umidade;
+    estimator_t oxigenio;
+    compost_phase_t phase;
+    int32_t eta;                    // Amostras até o próximo alarme previsto (-1 se nenhum)
+} forecast_t;
+
+// Estado de debounce de um botão. Cada botão tem o seu, para que cliques
+// em um botão não interfiram no debounce dos outros.
+typedef struct {
+    uint32_t last_time;             // Tempo da última interrupção aceita
+} button_t;
+
+// Processa um clique no tempo informado. Retorna true se o clique foi aceito
+// e informa em increase se deve incrementar ou decrementar o valor.
+bool button_event(button_t *btn, uint32_t current_time, bool *increase);
+
+// Simula a alteração de valores dos sensores.
+void update_data(int *data, bool increase);
+
+// Classifica as leituras em alarme, ideal ou normal.
+monitor_status_t evaluate_status(const readings_t *r);
+
+// Reinicia a previsão.
+void forecast_reset(forecast_t *f);
+
+// Incorpora uma amostra das leituras e atualiza fase e tempo até o alarme.
+void forecast_update(forecast_t *f, const readings_t *r);
+
+// Promove o estado para STATUS_WARNING se a previsão indicar alarme em breve.
+monitor_status_t apply_forecast(monitor_status_t status, const forecast_t *f);
+
+// Retorna o nome da fase para exibição.
+const char *phase_name(compost_phase_t phase);
+
+#endif // MONITOR_H
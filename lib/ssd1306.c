@@ -2,71 +2,90 @@
 #include "ssd1306.h"
 #include "font.h"
 
-void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_bus_t *bus) {
   ssd->width = width;
   ssd->height = height;
   ssd->pages = height / 8U;
   ssd->address = address;
-  ssd->i2c_port = i2c;
+  ssd->bus = bus;
+  ssd->failed = false;
   ssd->bufsize = ssd->pages * ssd->width + 1;
   ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
   ssd->ram_buffer[0] = 0x40;
-  ssd->port_buffer[0] = 0x80;
 }
 
-void ssd1306_config(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_DISP | 0x00);
-  ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
-  ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
-  ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
-  ssd1306_command(ssd, SET_MUX_RATIO);
-  ssd1306_command(ssd, HEIGHT - 1);
-  ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
-  ssd1306_command(ssd, SET_DISP_OFFSET);
-  ssd1306_command(ssd, 0x00);
-  ssd1306_command(ssd, SET_COM_PIN_CFG);
-  ssd1306_command(ssd, 0x12);
-  ssd1306_command(ssd, SET_DISP_CLK_DIV);
-  ssd1306_command(ssd, 0x80);
-  ssd1306_command(ssd, SET_PRECHARGE);
-  ssd1306_command(ssd, 0xF1);
-  ssd1306_command(ssd, SET_VCOM_DESEL);
-  ssd1306_command(ssd, 0x30);
-  ssd1306_command(ssd, SET_CONTRAST);
-  ssd1306_command(ssd, 0xFF);
-  ssd1306_command(ssd, SET_ENTIRE_ON);
-  ssd1306_command(ssd, SET_NORM_INV);
-  ssd1306_command(ssd, SET_CHARGE_PUMP);
-  ssd1306_command(ssd, 0x14);
-  ssd1306_command(ssd, SET_DISP | 0x01);
+// Se um bloco do quadro falhou, os seguintes também são descartados: o
+// ponteiro de escrita do display ficou fora de posição e eles seriam
+// desenhados no lugar errado. O próximo quadro é enviado inteiro depois
+// que o laço principal reconfigura o display.
+static void ssd1306_done(int result, void *ctx) {
+  ssd1306_t *ssd = ctx;
+  if (result < 0) {
+    ssd->failed = true;
+    i2c_bus_cancel(ssd->bus, ssd);
+  }
 }
 
-void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
-  ssd->port_buffer[1] = command;
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->port_buffer,
-    2,
-    false
-  );
+// Envia vários comandos em uma única transação (byte de controle 0x00)
+static bool ssd1306_commands(ssd1306_t *ssd, const uint8_t *commands, size_t len) {
+  return i2c_bus_write_prefixed(ssd->bus, ssd->address, I2C_PRIO_DISPLAY, 0x00,
+                                commands, len, ssd1306_done, ssd);
 }
 
-void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->ram_buffer,
-    ssd->bufsize,
-    false
-  );
+bool ssd1306_config(ssd1306_t *ssd) {
+  static const uint8_t commands[] = {
+    SET_DISP | 0x00,
+    SET_MEM_ADDR, 0x01,
+    SET_DISP_START_LINE | 0x00,
+    SET_SEG_REMAP | 0x01,
+    SET_MUX_RATIO, HEIGHT - 1,
+    SET_COM_OUT_DIR | 0x08,
+    SET_DISP_OFFSET, 0x00,
+    SET_COM_PIN_CFG, 0x12,
+    SET_DISP_CLK_DIV, 0x80,
+    SET_PRECHARGE, 0xF1,
+    SET_VCOM_DESEL, 0x30,
+    SET_CONTRAST, 0xFF,
+    SET_ENTIRE_ON,
+    SET_NORM_INV,
+    SET_CHARGE_PUMP, 0x14,
+    SET_DISP | 0x01
+  };
+
+  return ssd1306_commands(ssd, commands, sizeof(commands));
+}
+
+bool ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+  uint8_t buffer[2] = {0x80, command};
+  return i2c_bus_write(ssd->bus, ssd->address, I2C_PRIO_DISPLAY, buffer, 2, ssd1306_done, ssd);
+}
+
+// O quadro é enviado em blocos de width bytes, cada um em sua própria
+// transação, para que leituras de sensores possam ser executadas entre
+// eles. No endereçamento vertical cada bloco cobre width / pages colunas de
+// todas as páginas (16 colunas × 8 páginas no display de 128x64). O display
+// mantém o ponteiro de escrita entre transações, então os blocos continuam
+// de onde o anterior parou. Pelo mesmo motivo um bloco não é repetido: uma
+// falha no meio dele já avançou o ponteiro, e o reenvio sairia deslocado.
+bool ssd1306_send_data(ssd1306_t *ssd) {
+  const uint8_t window[] = {
+    SET_COL_ADDR, 0, ssd->width - 1,
+    SET_PAGE_ADDR, 0, ssd->pages - 1
+  };
+  size_t data_len = ssd->bufsize - 1;
+  size_t chunks = (data_len + ssd->width - 1) / ssd->width;
+
+  // Só enfileira o quadro se couber inteiro, para não deixar o display pela metade
+  if (i2c_bus_free(ssd->bus) < chunks + 1)
+    return false;
+
+  ssd1306_commands(ssd, window, sizeof(window));
+  for (size_t offset = 0; offset < data_len; offset += ssd->width) {
+    size_t len = data_len - offset < ssd->width ? data_len - offset : ssd->width;
+    i2c_bus_write_prefixed_once(ssd->bus, ssd->address, I2C_PRIO_DISPLAY, 0x40,
+                                &ssd->ram_buffer[offset + 1], len, ssd1306_done, ssd);
+  }
+  return true;
 }
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
@@ -91,34 +110,14 @@ void ssd1306_fill(ssd1306_t *ssd, bool value) {
 // Função para desenhar um caractere no display SSD1306
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
 {
-    uint16_t index = 0;
-
-    // Verifica se é uma letra maiúscula (A-Z)
-    if (c >= 'A' && c <= 'Z')
-    {
-        index = (c - 'A' + 11) * 8; // Offset para letras maiúsculas
-    }
-    // Verifica se é uma letra minúscula (a-z)
-    else if (c >= 'a' && c <= 'z')
-    {
-        index = (c - 'a' + 37) * 8; // Offset para letras minúsculas (após as maiúsculas)
-    }
-    // Verifica se é um dígito (0-9)
-    else if (c >= '0' && c <= '9')
-    {
-        index = (c - '0' + 1) * 8; // Offset para dígitos
-    }
-    else
-    {
-        // Se o caractere não for suportado, exibe um espaço (ou outro caractere padrão)
-        index = 0;
-    }
+    uint8_t scratch[FONT_WIDTH];
+    const uint8_t *glyph = font_glyph(c, scratch);
 
-    // Desenha o caractere no display, assumindo uma matriz de 8x8 pixels por caractere
-    for (uint8_t i = 0; i < 8; ++i)
+    // Desenha o caractere no display, uma coluna de FONT_HEIGHT pixels por byte
+    for (uint8_t i = 0; i < FONT_WIDTH; ++i)
     {
-        uint8_t line = font[index + i];
-        for (uint8_t j = 0; j < 8; ++j)
+        uint8_t line = glyph[i];
+        for (uint8_t j = 0; j < FONT_HEIGHT; ++j)
         {
             // Verifica se o bit j de 'line' está setado e desenha o pixel
             ssd1306_pixel(ssd, x + i, y + j, (line & (1 << j)) ? 1 : 0);
@@ -132,13 +131,13 @@ void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
   while (*str)
   {
     ssd1306_draw_char(ssd, *str++, x, y);
-    x += 8;
-    if (x + 8 >= ssd->width)
+    x += FONT_WIDTH;
+    if (x + FONT_WIDTH >= ssd->width)
     {
       x = 0;
-      y += 8;
+      y += FONT_HEIGHT;
     }
-    if (y + 8 >= ssd->height)
+    if (y + FONT_HEIGHT >= ssd->height)
     {
       break;
     }
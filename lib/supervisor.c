@@ -0,0 +1,146 @@
+#include <stddef.h>
+#include <string.h>
+#include "supervisor.h"
+
+/**
+ * @brief Inicializa a supervisão das tarefas.
+ *
+ * @param s supervisor.
+ * @param budget intervalo máximo entre heartbeats de cada tarefa (ms).
+ * @param now tempo atual (ms).
+ */
+void supervisor_init(supervisor_t *s, const uint32_t budget[TASK_COUNT], uint32_t now) {
+    for (int i = 0; i < TASK_COUNT; ++i) {
+        s->budget[i] = budget[i];
+        s->last_beat[i] = now;
+    }
+}
+
+
+/**
+ * @brief Registra que a tarefa está viva.
+ *
+ * @param s supervisor.
+ * @param task tarefa.
+ * @param now tempo atual (ms).
+ */
+void supervisor_beat(supervisor_t *s, task_id_t task, uint32_t now) {
+    s->last_beat[task] = now;
+}
+
+
+/**
+ * @brief Verifica se todas as tarefas sinalizaram dentro do prazo.
+ *
+ * @param s supervisor.
+ * @param now tempo atual (ms).
+ *
+ * @return a primeira tarefa fora do prazo ou TASK_COUNT se todas estão vivas.
+ */
+task_id_t supervisor_check(const supervisor_t *s, uint32_t now) {
+    for (int i = 0; i < TASK_COUNT; ++i) {
+        if (now - s->last_beat[i] > s->budget[i]) {
+            return (task_id_t)i;
+        }
+    }
+    return TASK_COUNT;
+}
+
+
+/**
+ * @brief Verificação periódica dos prazos, chamada pela interrupção do timer.
+ *
+ * Na primeira tarefa atrasada registra qual foi no estado preservado e
+ * para de liberar a alimentação do watchdog, que reinicia a placa.
+ *
+ * @param s supervisor.
+ * @param r estado preservado.
+ * @param now tempo atual (ms).
+ *
+ * @return true se todas as tarefas estão em dia e o watchdog pode ser alimentado.
+ */
+bool supervisor_tick(const supervisor_t *s, retained_t *r, uint32_t now) {
+    task_id_t late = supervisor_check(s, now);
+
+    if (late == TASK_COUNT) {
+        return true;
+    }
+    if (r->late_task == TASK_COUNT) {
+        r->late_task = late;
+        retained_seal(r);
+    }
+    return false;
+}
+
+
+/**
+ * @brief CRC-32 (polinômio refletido 0xEDB88320) calculado bit a bit,
+ * suficiente para os poucos bytes do estado preservado.
+ */
+static uint32_t crc32(const uint8_t *data, size_t len) {
+    uint32_t crc = 0xFFFFFFFFu;
+
+    while (len--) {
+        crc ^= *data++;
+        for (int i = 0; i < 8; ++i) {
+            crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1u));
+        }
+    }
+    return ~crc;
+}
+
+
+/**
+ * @brief Grava a marca e o CRC do estado preservado.
+ *
+ * @param r estado preservado.
+ */
+void retained_seal(retained_t *r) {
+    r->magic = RETAINED_MAGIC;
+    r->crc = crc32((const uint8_t *)r, offsetof(retained_t, crc));
+}
+
+
+/**
+ * @brief Verifica a marca e o CRC do estado preservado. Após a partida a
+ * frio o conteúdo da RAM é indefinido e a verificação falha.
+ *
+ * @param r estado preservado.
+ */
+bool retained_valid(const retained_t *r) {
+    return r->magic == RETAINED_MAGIC &&
+           r->late_task <= TASK_COUNT &&
+           r->crc == crc32((const uint8_t *)r, offsetof(retained_t, crc));
+}
+
+
+/**
+ * @brief Decide se a partida retoma o estado preservado.
+ *
+ * A partida é a quente somente após um reinício pelo watchdog com o
+ * estado íntegro e menos de RETAINED_MAX_RESTARTS reinícios seguidos; um
+ * estado que provoca reinícios em sequência é descartado. Nos demais
+ * casos o estado preservado é reiniciado.
+ *
+ * @param r estado preservado.
+ * @param watchdog_reboot indica se o reinício foi causado pelo watchdog.
+ *
+ * @return o tipo de partida.
+ */
+boot_t retained_boot(retained_t *r, bool watchdog_reboot) {
+    boot_t boot = BOOT_COLD;
+
+    if (watchdog_reboot && retained_valid(r)) {
+        if (r->restarts < RETAINED_MAX_RESTARTS) {
+            r->restarts++;
+            retained_seal(r);
+            return BOOT_WARM;
+        }
+        boot = BOOT_RESTART_LIMIT;
+    }
+
+    memset(r, 0, sizeof(*r));
+    r->late_task = TASK_COUNT;
+    retained_seal(r);
+    return boot;
+}
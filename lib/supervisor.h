@@ -0,0 +1,73 @@
+#ifndef SUPERVISOR_H
+#define SUPERVISOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "monitor.h"
+
+// Supervisão por watchdog e estado preservado entre reinícios.
+// Cada tarefa sinaliza que está viva (heartbeat) de forma independente; uma
+// interrupção periódica verifica os prazos com supervisor_tick() e só
+// alimenta o watchdog enquanto todas estão em dia. O estado do sistema é
+// guardado em RAM não inicializada com verificação de integridade, para que
+// um reinício a quente retome o monitoramento com as últimas leituras. Não
+// depende do hardware.
+
+#define RETAINED_MAGIC 0xC0470517u  // Marca de estado preservado válido
+#define RETAINED_MAX_RESTARTS 3     // Reinícios a quente seguidos antes de forçar a partida a frio
+
+typedef enum {
+    TASK_LOOP,                      // Laço principal
+    TASK_BUS,                       // Fila do barramento I2C esvaziada
+    TASK_MATRIX,                    // Atualização da matriz de LEDs
+    TASK_COUNT
+} task_id_t;
+
+typedef struct {
+    volatile uint32_t last_beat[TASK_COUNT]; // Último heartbeat de cada tarefa (ms), lido pela interrupção
+    uint32_t budget[TASK_COUNT];    // Intervalo máximo entre heartbeats (ms)
+} supervisor_t;
+
+// Tipo de partida decidido por retained_boot().
+typedef enum {
+    BOOT_COLD,                      // Energização, reset ou estado preservado inválido
+    BOOT_WARM,                      // Reinício pelo watchdog com estado íntegro
+    BOOT_RESTART_LIMIT              // Reinícios seguidos demais: partida a frio
+} boot_t;
+
+// Estado preservado entre reinícios a quente.
+typedef struct {
+    uint32_t magic;
+    uint32_t restarts;              // Reinícios a quente seguidos
+    uint32_t i2c_errors;
+    uint32_t matrix_errors;
+    readings_t leituras;
+    forecast_t forecast;
+    uint8_t status;                 // Último monitor_status_t
+    uint8_t late_task;              // Tarefa que perdeu o prazo (TASK_COUNT se nenhuma)
+    uint32_t crc;                   // CRC-32 de todos os campos anteriores
+} retained_t;
+
+// Inicializa a supervisão, considerando todas as tarefas vivas em now.
+void supervisor_init(supervisor_t *s, const uint32_t budget[TASK_COUNT], uint32_t now);
+
+// Registra o heartbeat de uma tarefa.
+void supervisor_beat(supervisor_t *s, task_id_t task, uint32_t now);
+
+// Retorna a primeira tarefa fora do prazo ou TASK_COUNT se todas estão vivas.
+task_id_t supervisor_check(const supervisor_t *s, uint32_t now);
+
+// Verificação periódica (interrupção). Retorna true se o watchdog pode ser
+// alimentado; caso contrário registra a tarefa atrasada em r.
+bool supervisor_tick(const supervisor_t *s, retained_t *r, uint32_t now);
+
+// Atualiza a marca e o CRC após alterar o estado preservado.
+void retained_seal(retained_t *r);
+
+// Verifica se o estado preservado está íntegro.
+bool retained_valid(const retained_t *r);
+
+// Decide o tipo de partida. Na partida a frio o estado preservado é reiniciado.
+boot_t retained_boot(retained_t *r, bool watchdog_reboot);
+
+#endif // SUPERVISOR_H
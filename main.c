@@ -13,8 +13,13 @@
 #include "hardware/i2c.h"
 #include "hardware/pwm.h"
 #include "hardware/pio.h"
+#include "hardware/sync.h"
+#include "hardware/watchdog.h"
 #include "lib/ssd1306.h"
+#include "lib/i2c_bus_pico.h"
 #include "lib/led.h"
+#include "lib/control.h"
+#include "lib/supervisor.h"
 #include "lib/WS2812.h"
 #include "WS2812.pio.h"
 
@@ -29,12 +34,6 @@
 #define BTN_B 6                     // Pino do botão B conectado ao GPIO 6.
 #define BTN_STICK 22                // Pino do botão do Joystick conectado ao GPIO 22.
 
-#define DEBOUNCE_TIME 200000        // Tempo para debounce em ms
-#define WAIT_TIME     1000000       // ...
-uint32_t last_time = 0;             // Tempo da última interrupção do botão do Joystick
-static uint32_t last_time_A = 0;    // Tempo da última interrupção do botão A
-static uint32_t last_time_B = 0;    // Tempo da última interrupção do botão B
-
 #define PWM_FREQ   20000            // 20 kHz
 #define PWM_WRAP   255              // Valor do WRAP (período) para o PWM. 8 bits de wrap (256 valores)
 const float DIVIDER_PWM = 125.0;    // Valor do divisor de clock para o PWM.
@@ -45,19 +44,42 @@ const float DIVIDER_PWM = 125.0;    // Valor do divisor de clock para o PWM.
 
 #define BUZZER_PIN 10 // Pino do Buzzer conectado ao GPIO 10.
 
+#define WATCHDOG_MS 3000            // Tempo sem alimentar o watchdog até o reinício
+#define SUPERVISOR_MS 100           // Período da verificação dos heartbeats
+#define STABLE_CYCLES 60            // Ciclos sem reinício que zeram a contagem de reinícios seguidos
+
+// Intervalo máximo (ms) entre heartbeats de cada tarefa
+static const uint32_t task_budget[TASK_COUNT] = {
+    [TASK_LOOP]   = 2500,           // Um ciclo leva ~1,5 s no pior caso (alarme)
+    [TASK_BUS]    = 2000,           // A fila I2C deve esvaziar a cada ciclo
+    [TASK_MATRIX] = 2500,           // A matriz aceita um quadro a cada ciclo
+};
+
 // --- VARIAVEIS GLOBAIS
 
+i2c_bus_pico_t i2c_hw = {I2C_PORT, I2C_SDA, I2C_SCL, 400 * 1000};
+i2c_bus_t i2c_bus;                  // Gerenciador do barramento I2C, dono da porta
 ssd1306_t ssd;
-int temperatura = 39;
-int umidade = 49;
-int oxigenio = 14;
+control_t control;                  // Leituras, previsão e estado do laço principal
 PIO pio = pio0;
 uint sm = 0;
+uint32_t cycles = 0;                // Ciclos do laço principal
+supervisor_t supervisor;            // Heartbeats das tarefas supervisionadas pelo watchdog
+bool warm_boot = false;             // Indica reinício a quente pelo watchdog
+repeating_timer_t supervisor_timer; // Verificação periódica dos heartbeats
+
+// Estado preservado entre reinícios: fica fora da área zerada na partida
+static retained_t __uninitialized_ram(retained);
+
+#define STATS_CYCLES 60             // Intervalo (ciclos) entre relatórios do barramento
 
 // --- DECLARAÇÃO DE FUNÇÕES
 
-void update_data(int *data, bool increase);
-void write_display(ssd1306_t *ssd);
+void wait_ms(uint32_t ms);
+bool supervise(repeating_timer_t *timer);
+void save_state();
+void restore_state(boot_t boot);
+void report_bus();
 void irq_buttons(uint gpio, uint32_t events);
 void beep_buzzer();
 void buzzer_tone(int frequency);
@@ -75,109 +97,178 @@ void setup_led(uint pin);
 int main() {
     setup();
 
-    clear_matrix(pio, sm);
+    // Após reinício a quente a matriz é redesenhada no primeiro ciclo
+    if (!warm_boot) {
+        clear_matrix(pio, sm);
+    }
 
     while (1) {
-        write_display(&ssd);
-
-        if ((temperatura > 60) || (umidade > 70) || (oxigenio < 15)) {
-            set_led(LED_R, 1);
-            set_led(LED_G, 0);
-            set_led(LED_B, 0);
+        supervisor_beat(&supervisor, TASK_LOOP, to_ms_since_boot(get_absolute_time()));
 
-            set_led_matrix(11, pio, sm);
+        control_cycle(&control);
 
-            buzzer_tone(50); 
-            sleep_ms(500);
-            buzzer_off();      
-        }
-        else if ((40 < temperatura && temperatura < 60) && (50 < umidade && umidade < 70) && (oxigenio > 15)) {
-            set_led(LED_R, 0);
-            set_led(LED_G, 1);
-            set_led(LED_B, 0);
-            set_led_matrix(15, pio, sm);
-        }
-        else {
-            set_led(LED_R, 0);
-            set_led(LED_G, 0);
-            set_led(LED_B, 1);
-            set_led_matrix(15, pio, sm);
+        if (++cycles == STABLE_CYCLES) {
+            retained.restarts = 0;
         }
+        save_state();
 
-        sleep_ms(1000);
+        if (cycles % STATS_CYCLES == 0) {
+            report_bus();
+        }
     }
 }
 
 
 /**
- * @brief Função de interrupção para os botões com debouncing.
- * 
- * @param gpio a GPIO que gerou interrupção.
- * @param events a evento que gerou interrupção.
+ * @brief Acende o LED RGB com as cores informadas.
  */
-void irq_buttons(uint gpio, uint32_t events){
-    uint32_t current_time = to_us_since_boot(get_absolute_time());
-    
-    if(current_time - last_time > DEBOUNCE_TIME){
-        bool increase = (current_time - last_time) > WAIT_TIME;  // Se o tempo entre cliques for grande, aumenta, senão, diminui
-
-        switch (gpio) {
-        case BTN_A:
-            update_data(&temperatura, increase);
-            break;
-        case BTN_B:
-            update_data(&umidade, increase);
-            break;
-        case BTN_STICK:
-            update_data(&oxigenio, increase);
-            break;
-        default:
-            break;
-        }
+static void hw_set_rgb(void *hw, bool r, bool g, bool b) {
+    set_led(LED_R, r);
+    set_led(LED_G, g);
+    set_led(LED_B, b);
+}
 
-        last_time = current_time; // Atualiza o tempo para o debounce
+
+/**
+ * @brief Exibe um ícone na matriz de LEDs. A matriz só sinaliza que está
+ * viva quando a FIFO aceita o quadro.
+ *
+ * @return false se a FIFO da PIO não aceitou o quadro a tempo.
+ */
+static bool hw_show_icon(void *hw, uint8_t icon) {
+    bool sent = set_led_matrix(icon, pio, sm);
+    if (sent) {
+        supervisor_beat(&supervisor, TASK_MATRIX, to_ms_since_boot(get_absolute_time()));
     }
+    return sent;
 }
 
 
 /**
- * @brief Simula a alteração de valores dos sensores.
- * 
- * @param data variável que irá ser alterada.
- * @param increase booleano que informa se é incremento ou decremento de valor.
+ * @brief Liga ou desliga o buzzer.
  */
-void update_data(int *data, bool increase) {
-    if (increase) {
-        *data += 5;
+static void hw_buzzer(void *hw, bool on) {
+    if (on) {
+        buzzer_tone(50);
     } else {
-        *data -= 5;
+        buzzer_off();
     }
 }
 
 
+static void hw_wait_ms(void *hw, uint32_t ms) {
+    wait_ms(ms);
+}
+
+
+static const control_ops_t control_ops = {
+    .set_rgb = hw_set_rgb,
+    .show_icon = hw_show_icon,
+    .buzzer = hw_buzzer,
+    .wait_ms = hw_wait_ms,
+};
+
+
 /**
- * @brief Atualiza o display com o estado dos LEDs.
+ * @brief Aguarda o tempo informado executando as transações I2C pendentes.
  *
- * @param ssd Ponteiro para a estrutura do display.
+ * @param ms tempo de espera em milissegundos.
  */
-void write_display(ssd1306_t *ssd) {
-    // Limpa o display
-    ssd1306_fill(ssd, false);
+void wait_ms(uint32_t ms) {
+    absolute_time_t deadline = make_timeout_time_ms(ms);
 
-    char msg_temp[20];  // Buffer para armazenar a string formatada
-    sprintf(msg_temp, "Temperatura %d", temperatura);
-    ssd1306_draw_string(ssd, msg_temp, 0, 0);
+    while (absolute_time_diff_us(get_absolute_time(), deadline) > 0) {
+        if (!i2c_bus_process(&i2c_bus)) {
+            supervisor_beat(&supervisor, TASK_BUS, to_ms_since_boot(get_absolute_time()));
+            sleep_ms(1);
+        }
+    }
+}
 
-    char msg_umid[20];  // Buffer para armazenar a string formatada
-    sprintf(msg_umid, "Umidade %d", umidade);
-    ssd1306_draw_string(ssd, msg_umid, 0, 15);
 
-    char msg_oxig[20];  // Buffer para armazenar a string formatada
-    sprintf(msg_oxig, "Oxigenio %d", oxigenio);
-    ssd1306_draw_string(ssd, msg_oxig, 0, 30);
+/**
+ * @brief Verifica os heartbeats a cada SUPERVISOR_MS, fora do laço
+ * principal, e alimenta o watchdog se todas as tarefas estiverem em dia.
+ * Caso contrário a tarefa atrasada fica registrada e o timer é encerrado,
+ * deixando o watchdog reiniciar a placa mesmo que o laço esteja travado.
+ *
+ * @return false para encerrar o timer.
+ */
+bool supervise(repeating_timer_t *timer) {
+    if (supervisor_tick(&supervisor, &retained, to_ms_since_boot(get_absolute_time()))) {
+        watchdog_update();
+        return true;
+    }
+    return false;
+}
 
-    // Atualiza o display
-    ssd1306_send_data(ssd); 
+
+/**
+ * @brief Guarda leituras, previsão e contadores para um reinício a quente.
+ * A interrupção do supervisor também altera o estado preservado, então a
+ * gravação é feita com as interrupções desabilitadas.
+ */
+void save_state() {
+    uint32_t irq = save_and_disable_interrupts();
+    control_save(&control, &retained);
+    restore_interrupts(irq);
+}
+
+
+/**
+ * @brief Retoma o estado preservado após um reinício a quente ou registra
+ * a partida a frio.
+ *
+ * @param boot tipo de partida decidido por retained_boot.
+ */
+void restore_state(boot_t boot) {
+    if (boot == BOOT_WARM) {
+        control_restore(&control, &retained);
+        printf("Reinicio pelo watchdog (%lu seguidos), tarefa atrasada: %d\n",
+               (unsigned long)retained.restarts, retained.late_task);
+        retained.late_task = TASK_COUNT;
+    } else if (boot == BOOT_RESTART_LIMIT) {
+        printf("Limite de %d reinicios seguidos: partida a frio\n", RETAINED_MAX_RESTARTS);
+    }
+    save_state();
+}
+
+
+/**
+ * @brief Imprime as métricas de uso do barramento I2C.
+ */
+void report_bus() {
+    const i2c_bus_stats_t *stats = &i2c_bus.stats;
+    uint32_t usage = i2c_bus_utilization(&i2c_bus);
+
+    printf("I2C: uso %lu%%, ok %lu, falhas %lu, recusadas %lu, canceladas %lu, resets %lu\n",
+           (unsigned long)usage, (unsigned long)stats->completed, (unsigned long)stats->failed,
+           (unsigned long)stats->rejected, (unsigned long)stats->cancelled, (unsigned long)stats->resets);
+}
+
+
+/**
+ * @brief Função de interrupção para os botões com debouncing.
+ * 
+ * @param gpio a GPIO que gerou interrupção.
+ * @param events a evento que gerou interrupção.
+ */
+void irq_buttons(uint gpio, uint32_t events){
+    uint32_t current_time = to_us_since_boot(get_absolute_time());
+
+    switch (gpio) {
+    case BTN_A:
+        control_button(&control, BUTTON_A, current_time);
+        break;
+    case BTN_B:
+        control_button(&control, BUTTON_B, current_time);
+        break;
+    case BTN_STICK:
+        control_button(&control, BUTTON_STICK, current_time);
+        break;
+    default:
+        break;
+    }
 }
 
 
@@ -204,6 +295,10 @@ void buzzer_off() {
  * @brief Inicialização e configuração geral.
 */
 void setup() {
+    // Reinício causado pelo watchdog com estado íntegro: retoma sem esperas
+    boot_t boot = retained_boot(&retained, watchdog_enable_caused_reboot());
+    warm_boot = boot == BOOT_WARM;
+
     // Inicializa entradas e saídas
     stdio_init_all();
 
@@ -213,8 +308,10 @@ void setup() {
     uint offset = pio_add_program(pio, &pio_matrix_program);
     pio_matrix_program_init(pio, sm, offset, WS2812_PIN);
 
-    // Aguarda a conexão USB
-    sleep_ms(2000); 
+    // Aguarda a conexão USB apenas na partida a frio
+    if (!warm_boot) {
+        sleep_ms(2000);
+    }
 
     // Configura os LEDs RGB
     setup_led(LED_R);
@@ -234,26 +331,41 @@ void setup() {
     gpio_set_irq_enabled_with_callback(BTN_B, GPIO_IRQ_EDGE_RISE, true, &irq_buttons);
     gpio_set_irq_enabled_with_callback(BTN_STICK, GPIO_IRQ_EDGE_FALL, true, &irq_buttons); 
 
-    // Inicializa I2C com 400 Khz
-    i2c_init(I2C_PORT, 400 * 1000);
-    gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);                    // Set the GPIO pin function to I2C
-    gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);                    // Set the GPIO pin function to I2C
-    gpio_pull_up(I2C_SDA);                                        // Pull up the data line
-    gpio_pull_up(I2C_SCL);                                        // Pull up the clock line
+    // Inicializa I2C com 400 Khz e o gerenciador do barramento
+    i2c_bus_pico_init(&i2c_bus, &i2c_hw);
 
     // Configura display
     setup_display();
+
+    restore_state(boot);
+
+    // Inicia a supervisão por watchdog, verificada pela interrupção do timer
+    supervisor_init(&supervisor, task_budget, to_ms_since_boot(get_absolute_time()));
+    watchdog_enable(WATCHDOG_MS, true);
+    add_repeating_timer_ms(-SUPERVISOR_MS, supervise, NULL, &supervisor_timer);
 }
 
 
 /**
  * @brief Configura Display ssd1306 via I2C, iniciando com todos os pixels desligados.
+ * Após reinício a quente o display manteve a configuração, então apenas o
+ * barramento é liberado, caso o reinício tenha ocorrido no meio de uma transferência.
 */
 void setup_display() {
-    ssd1306_init(&ssd, WIDTH, HEIGHT, false, endereco, I2C_PORT); // Inicializa o display
-    ssd1306_config(&ssd);    
-    ssd1306_send_data(&ssd);   
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, endereco, &i2c_bus); // Inicializa o display
+    control_init(&control, &control_ops, NULL, &ssd);
+
+    if (warm_boot) {
+        i2c_bus_recover(&i2c_bus);
+        control.display_ok = true;
+        return;
+    }
+
     ssd1306_fill(&ssd, false);
+    control.display_ok = ssd1306_config(&ssd) && ssd1306_send_data(&ssd);
+    i2c_bus_flush(&i2c_bus);
+    control.display_ok = control.display_ok && !ssd.failed;
+    ssd.failed = false;
 }
 
 
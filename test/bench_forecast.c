@@ -0,0 +1,56 @@
+// Custo de uma atualização da previsão no host. O laço principal chama
+// forecast_update uma vez por ciclo; aqui ela é repetida com leituras
+// variadas para medir o tempo médio por chamada. É só uma medida: não
+// está registrada no ctest, já que o tempo depende da máquina e da carga.
+// Em x86 também mostra os ciclos do TSC, que contam a uma taxa fixa e não
+// necessariamente na frequência atual do núcleo.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include "monitor.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#endif
+
+#define UPDATES 5000000
+
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+
+int main(void) {
+    forecast_t f;
+    forecast_reset(&f);
+    unsigned state = 1;
+    volatile int32_t sink = 0;
+
+    double start = now_ns();
+#ifdef HAVE_TSC
+    uint64_t start_tsc = __rdtsc();
+#endif
+    for (int i = 0; i < UPDATES; i++) {
+        state = state * 1103515245u + 12345u;
+        int noise = (int)((state >> 16) % 3) - 1;
+        readings_t r = {40 + (i / 8) % 25 + noise, 50 + (i / 16) % 20, 20 - (i / 32) % 6};
+        forecast_update(&f, &r);
+        sink += f.eta;
+    }
+#ifdef HAVE_TSC
+    double cycles = (double)(__rdtsc() - start_tsc) / UPDATES;
+#endif
+    double ns = (now_ns() - start) / UPDATES;
+
+    printf("forecast_update: %.1f ns por atualização (%d atualizações)\n", ns, UPDATES);
+#ifdef HAVE_TSC
+    printf("forecast_update: %.1f ciclos do TSC por atualização\n", cycles);
+#endif
+    (void)sink;
+    return 0;
+}
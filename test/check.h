@@ -0,0 +1,28 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <stdio.h>
+
+// Verificações mínimas para os testes no host. Cada falha é impressa com
+// arquivo e linha; o teste termina com CHECK_RESULT().
+
+static int check_failures;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "%s:%d: falhou: %s\n", __FILE__, __LINE__, #cond); \
+        check_failures++; \
+    } \
+} while (0)
+
+#define CHECK_EQ(actual, expected) do { \
+    long long a_ = (long long)(actual), e_ = (long long)(expected); \
+    if (a_ != e_) { \
+        fprintf(stderr, "%s:%d: %s = %lld, esperado %lld\n", __FILE__, __LINE__, #actual, a_, e_); \
+        check_failures++; \
+    } \
+} while (0)
+
+#define CHECK_RESULT() (check_failures ? (fprintf(stderr, "%d falha(s)\n", check_failures), 1) : 0)
+
+#endif // CHECK_H
@@ -0,0 +1,414 @@
+// Reproduz um trace de sensores, botões e falhas na placa simulada e
+// verifica os estados esperados e o tempo de cada ciclo.
+//
+// Formato (uma diretiva por linha, '#' inicia comentário, tempos em ms):
+//
+//   run <ms>                          duração simulada
+//   budget <ms>                       duração máxima de um ciclo, incluindo a espera
+//   <t> button A|B|STICK              clique (a ISR chama control_button)
+//   <t> set <leitura> <valor>         altera temperatura, umidade ou oxigenio
+//   <t1>..<t2> ramp <leitura> <v1> <v2>  rampa linear, uma amostra por segundo
+//   <t> nak <n>                       as próximas n transferências I2C recebem NAK
+//   <t> timeout <n>                   as próximas n transferências I2C estouram o tempo
+//   <t> stall <ms>                    a FIFO da PIO fica cheia por <ms>
+//   <t> expect <campo> <op> <valor>   verificado no primeiro ciclo iniciado em t ou depois
+//   <t1>..<t2> expect <campo> <op> <valor>  verificado em todo ciclo iniciado no intervalo
+//
+// Campos: status (NORMAL, IDEAL, WARNING, ALARM), phase (MESOPHILIC,
+// THERMOPHILIC, COOLING), display e matrix (ok, fail), buzzer (on, off),
+// temperatura, umidade, oxigenio, eta, i2c_errors, matrix_errors, resets.
+// Operadores: == != >= <=. As leituras são as usadas pelo ciclo (valores no
+// seu início); os demais campos são verificados ao fim do ciclo.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sim.h"
+
+#define MAX_EVENTS  1024
+#define MAX_EXPECTS 256
+
+typedef enum { EV_BUTTON, EV_SET, EV_NAK, EV_TIMEOUT, EV_STALL } event_kind_t;
+
+typedef struct {
+    uint64_t at_us;
+    event_kind_t kind;
+    int target;                     // Botão ou leitura
+    int value;
+} event_t;
+
+typedef enum { OP_EQ, OP_NE, OP_GE, OP_LE } op_t;
+
+typedef struct {
+    uint64_t from_us;
+    uint64_t to_us;
+    bool range;
+    bool checked;
+    int field;
+    op_t op;
+    int value;
+    int line;
+} expect_t;
+
+typedef struct {
+    const char *path;
+    uint64_t run_us;
+    uint64_t budget_us;
+    int budget_line;
+    event_t events[MAX_EVENTS];
+    size_t event_count;
+    size_t next_event;
+    expect_t expects[MAX_EXPECTS];
+    size_t expect_count;
+} trace_t;
+
+static const char *const readings[] = {"temperatura", "umidade", "oxigenio", NULL};
+static const char *const buttons[] = {"A", "B", "STICK", NULL};
+static const char *const fields[] = {
+    "status", "phase", "display", "matrix", "buzzer", "temperatura", "umidade", "oxigenio",
+    "eta", "i2c_errors", "matrix_errors", "resets", NULL
+};
+enum {
+    F_STATUS, F_PHASE, F_DISPLAY, F_MATRIX, F_BUZZER, F_TEMPERATURA, F_UMIDADE, F_OXIGENIO,
+    F_ETA, F_I2C_ERRORS, F_MATRIX_ERRORS, F_RESETS
+};
+static const char *const statuses[] = {"NORMAL", "IDEAL", "WARNING", "ALARM", NULL};
+static const char *const phases[] = {"MESOPHILIC", "THERMOPHILIC", "COOLING", NULL};
+static const char *const fail_ok[] = {"fail", "ok", NULL};
+static const char *const off_on[] = {"off", "on", NULL};
+static const char *const ops[] = {"==", "!=", ">=", "<=", NULL};
+
+
+static int lookup(const char *const *names, const char *name) {
+    for (int i = 0; names[i]; i++) {
+        if (strcmp(names[i], name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+
+// Nomes aceitos como valor de cada campo (NULL para campos numéricos)
+static const char *const *field_names(int field) {
+    switch (field) {
+    case F_STATUS: return statuses;
+    case F_PHASE: return phases;
+    case F_DISPLAY:
+    case F_MATRIX: return fail_ok;
+    case F_BUZZER: return off_on;
+    default: return NULL;
+    }
+}
+
+
+static void add_event(trace_t *t, int line, uint64_t at_us, event_kind_t kind, int target, int value) {
+    if (t->event_count == MAX_EVENTS) {
+        fprintf(stderr, "%s:%d: eventos demais\n", t->path, line);
+        exit(2);
+    }
+    t->events[t->event_count++] = (event_t){at_us, kind, target, value};
+}
+
+
+static int cmp_events(const void *a, const void *b) {
+    const event_t *x = a, *y = b;
+    if (x->at_us != y->at_us) {
+        return x->at_us < y->at_us ? -1 : 1;
+    }
+    return 0;
+}
+
+
+static void parse_error(const trace_t *t, int line, const char *msg) {
+    fprintf(stderr, "%s:%d: %s\n", t->path, line, msg);
+    exit(2);
+}
+
+
+static bool parse_int(const char *s, int *out) {
+    char *end;
+    long v = strtol(s, &end, 10);
+    if (!*s || *end) {
+        return false;
+    }
+    *out = (int)v;
+    return true;
+}
+
+
+static void parse_line(trace_t *t, int line, char *text) {
+    char *hash = strchr(text, '#');
+    if (hash) {
+        *hash = '\0';
+    }
+
+    char *argv[8];
+    int argc = 0;
+    for (char *tok = strtok(text, " \t\r\n"); tok && argc < 8; tok = strtok(NULL, " \t\r\n")) {
+        argv[argc++] = tok;
+    }
+    if (argc == 0) {
+        return;
+    }
+
+    int v;
+    if (strcmp(argv[0], "run") == 0 || strcmp(argv[0], "budget") == 0) {
+        if (argc != 2 || !parse_int(argv[1], &v) || v <= 0) {
+            parse_error(t, line, "esperado 'run|budget <ms>'");
+        }
+        if (argv[0][0] == 'r') {
+            t->run_us = v * 1000ull;
+        } else {
+            t->budget_us = v * 1000ull;
+            t->budget_line = line;
+        }
+        return;
+    }
+
+    // Tempo: <t> ou <t1>..<t2>
+    int from, to;
+    char *dots = strstr(argv[0], "..");
+    if (dots) {
+        *dots = '\0';
+        if (!parse_int(argv[0], &from) || !parse_int(dots + 2, &to) || to < from) {
+            parse_error(t, line, "intervalo de tempo inválido");
+        }
+    } else if (parse_int(argv[0], &from)) {
+        to = from;
+    } else {
+        parse_error(t, line, "diretiva desconhecida");
+    }
+    if (from < 0 || argc < 2) {
+        parse_error(t, line, "tempo ou ação ausente");
+    }
+    uint64_t at = from * 1000ull;
+    const char *action = argv[1];
+
+    if (strcmp(action, "button") == 0 && argc == 3 && !dots) {
+        int b = lookup(buttons, argv[2]);
+        if (b < 0) {
+            parse_error(t, line, "botão desconhecido");
+        }
+        add_event(t, line, at, EV_BUTTON, b, 0);
+    } else if (strcmp(action, "set") == 0 && argc == 4 && !dots) {
+        int r = lookup(readings, argv[2]);
+        if (r < 0 || !parse_int(argv[3], &v)) {
+            parse_error(t, line, "esperado 'set <leitura> <valor>'");
+        }
+        add_event(t, line, at, EV_SET, r, v);
+    } else if (strcmp(action, "ramp") == 0 && argc == 5 && dots) {
+        int r = lookup(readings, argv[2]);
+        int v1, v2;
+        if (r < 0 || !parse_int(argv[3], &v1) || !parse_int(argv[4], &v2)) {
+            parse_error(t, line, "esperado '<t1>..<t2> ramp <leitura> <v1> <v2>'");
+        }
+        for (int ms = from; ms <= to; ms += 1000) {
+            int value = to == from ? v2 : v1 + (int)((long)(v2 - v1) * (ms - from) / (to - from));
+            add_event(t, line, ms * 1000ull, EV_SET, r, value);
+        }
+    } else if ((strcmp(action, "nak") == 0 || strcmp(action, "timeout") == 0 || strcmp(action, "stall") == 0)
+               && argc == 3 && !dots) {
+        if (!parse_int(argv[2], &v) || v <= 0) {
+            parse_error(t, line, "quantidade inválida");
+        }
+        event_kind_t kind = action[0] == 'n' ? EV_NAK : action[0] == 't' ? EV_TIMEOUT : EV_STALL;
+        add_event(t, line, at, kind, 0, v);
+    } else if (strcmp(action, "expect") == 0 && argc == 5) {
+        int field = lookup(fields, argv[2]);
+        int op = lookup(ops, argv[3]);
+        const char *const *names = field < 0 ? NULL : field_names(field);
+        if (field < 0 || op < 0) {
+            parse_error(t, line, "campo ou operador desconhecido");
+        }
+        v = names ? lookup(names, argv[4]) : 0;
+        if (names ? v < 0 : !parse_int(argv[4], &v)) {
+            parse_error(t, line, "valor inválido para o campo");
+        }
+        if (t->expect_count == MAX_EXPECTS) {
+            parse_error(t, line, "verificações demais");
+        }
+        t->expects[t->expect_count++] = (expect_t){
+            .from_us = at, .to_us = to * 1000ull, .range = dots != NULL,
+            .field = field, .op = (op_t)op, .value = v, .line = line,
+        };
+    } else {
+        parse_error(t, line, "diretiva inválida");
+    }
+}
+
+
+static void load(trace_t *t, const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        exit(2);
+    }
+
+    memset(t, 0, sizeof(*t));
+    t->path = path;
+    char text[256];
+    for (int line = 1; fgets(text, sizeof(text), f); line++) {
+        parse_line(t, line, text);
+    }
+    fclose(f);
+
+    if (!t->run_us || !t->budget_us) {
+        parse_error(t, 1, "'run' e 'budget' são obrigatórios");
+    }
+    // Ordenação estável não é necessária: eventos no mesmo instante são independentes
+    qsort(t->events, t->event_count, sizeof(event_t), cmp_events);
+}
+
+
+// Aplica os eventos cujo tempo já chegou. Chamada antes de cada ciclo e a cada passo da espera.
+static void apply_events(sim_t *s, void *ctx) {
+    trace_t *t = ctx;
+
+    while (t->next_event < t->event_count && t->events[t->next_event].at_us <= s->now_us) {
+        const event_t *e = &t->events[t->next_event++];
+        switch (e->kind) {
+        case EV_BUTTON:
+            control_button(&s->control, (button_id_t)e->target, (uint32_t)s->now_us);
+            break;
+        case EV_SET: {
+            int *reading[] = {&s->control.temperatura, &s->control.umidade, &s->control.oxigenio};
+            *reading[e->target] = e->value;
+            break;
+        }
+        case EV_NAK:
+            s->nak_pending += e->value;
+            break;
+        case EV_TIMEOUT:
+            s->timeout_pending += e->value;
+            break;
+        case EV_STALL:
+            s->stall_until = s->now_us + e->value * 1000ull;
+            break;
+        }
+    }
+}
+
+
+static int field_value(const sim_t *s, const readings_t *r, int field) {
+    const control_t *c = &s->control;
+    switch (field) {
+    case F_STATUS: return c->status;
+    case F_PHASE: return c->forecast.phase;
+    case F_DISPLAY: return c->display_ok;
+    case F_MATRIX: return c->matrix_ok;
+    case F_BUZZER: return s->buzzer;
+    case F_TEMPERATURA: return r->temperatura;
+    case F_UMIDADE: return r->umidade;
+    case F_OXIGENIO: return r->oxigenio;
+    case F_ETA: return c->forecast.eta;
+    case F_I2C_ERRORS: return (int)c->i2c_errors;
+    case F_MATRIX_ERRORS: return (int)c->matrix_errors;
+    default: return (int)s->bus.stats.resets;
+    }
+}
+
+
+static bool compare(op_t op, int a, int b) {
+    switch (op) {
+    case OP_EQ: return a == b;
+    case OP_NE: return a != b;
+    case OP_GE: return a >= b;
+    default: return a <= b;
+    }
+}
+
+
+static const char *value_name(int field, int value, char *buf) {
+    const char *const *names = field_names(field);
+    if (names && value >= 0 && names[value]) {
+        return names[value];
+    }
+    sprintf(buf, "%d", value);
+    return buf;
+}
+
+
+// Verifica as expectativas do ciclo iniciado em start_us. Retorna o número de falhas.
+static int check(trace_t *t, const sim_t *s, const readings_t *r, uint64_t start_us, uint32_t cycle) {
+    int failures = 0;
+
+    for (size_t i = 0; i < t->expect_count; i++) {
+        expect_t *e = &t->expects[i];
+        bool due = e->range ? (start_us >= e->from_us && start_us <= e->to_us)
+                            : (!e->checked && start_us >= e->from_us);
+        if (!due) {
+            continue;
+        }
+        e->checked = true;
+
+        int actual = field_value(s, r, e->field);
+        if (!compare(e->op, actual, e->value)) {
+            char a[16], b[16];
+            fprintf(stderr, "%s:%d: ciclo %u (t=%llu ms): %s %s %s, obtido %s\n", t->path, e->line,
+                    (unsigned)cycle, (unsigned long long)(start_us / 1000), fields[e->field], ops[e->op],
+                    value_name(e->field, e->value, b), value_name(e->field, actual, a));
+            failures++;
+        }
+    }
+    return failures;
+}
+
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        fprintf(stderr, "uso: %s <trace>\n", argv[0]);
+        return 2;
+    }
+
+    static trace_t trace;
+    static sim_t sim;
+    trace_t *t = &trace;
+    sim_t *s = &sim;
+    load(t, argv[1]);
+
+    sim_init(s);
+    s->on_tick = apply_events;
+    s->tick_ctx = t;
+
+    clock_t wall = clock();
+    uint32_t cycles = 0;
+    uint64_t worst_us = 0;
+    int failures = 0;
+
+    while (s->now_us < t->run_us) {
+        apply_events(s, t);
+        uint64_t start = s->now_us;
+        readings_t used = {s->control.temperatura, s->control.umidade, s->control.oxigenio};
+        control_cycle(&s->control);
+        uint64_t elapsed = s->now_us - start;
+
+        if (elapsed > worst_us) {
+            worst_us = elapsed;
+        }
+        if (elapsed > t->budget_us) {
+            fprintf(stderr, "%s:%d: ciclo %u (t=%llu ms) levou %.1f ms\n", t->path, t->budget_line,
+                    (unsigned)cycles, (unsigned long long)(start / 1000), elapsed / 1000.0);
+            failures++;
+        }
+        failures += check(t, s, &used, start, cycles);
+        cycles++;
+    }
+
+    for (size_t i = 0; i < t->expect_count; i++) {
+        if (!t->expects[i].checked) {
+            fprintf(stderr, "%s:%d: nenhum ciclo no tempo indicado\n", t->path, t->expects[i].line);
+            failures++;
+        }
+    }
+
+    double wall_ms = (clock() - wall) * 1000.0 / CLOCKS_PER_SEC;
+    printf("%s: %u ciclos em %.0f s simulados (%.1f ms no host), ciclo máximo %.1f ms, "
+           "%u erros I2C, %u recuperações, %u quadros da matriz perdidos\n",
+           argv[1], (unsigned)cycles, s->now_us / 1e6, wall_ms, worst_us / 1000.0,
+           (unsigned)s->control.i2c_errors, (unsigned)s->bus.stats.resets, (unsigned)s->control.matrix_errors);
+
+    sim_free(s);
+    return failures ? 1 : 0;
+}
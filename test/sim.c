@@ -0,0 +1,145 @@
+#include <stdlib.h>
+#include "sim.h"
+#include "assets.h"
+
+#define SIM_COLOR 0x02140au         // Mesma cor usada por set_led_matrix
+
+
+static int sim_i2c_write(void *hw, uint8_t address, const uint8_t *src, size_t len, bool nostop, uint32_t timeout_us) {
+    sim_t *s = hw;
+
+    if (s->nak_pending) {
+        s->nak_pending--;
+        s->now_us += SIM_I2C_BYTE_US;   // O NAK vem logo após o endereço
+        return -1;
+    }
+    if (s->timeout_pending) {
+        s->timeout_pending--;
+        s->now_us += timeout_us;
+        return -2;
+    }
+    s->now_us += SIM_I2C_BYTE_US * (len + 1);
+    s->i2c_transfers++;
+    return (int)len;
+}
+
+static int sim_i2c_read(void *hw, uint8_t address, uint8_t *dst, size_t len, uint32_t timeout_us) {
+    for (size_t i = 0; i < len; i++) {
+        dst[i] = 0;
+    }
+    return sim_i2c_write(hw, address, dst, len, false, timeout_us);
+}
+
+static void sim_i2c_reset(void *hw) {
+    sim_t *s = hw;
+    s->now_us += SIM_I2C_RESET_US;
+    s->i2c_resets++;
+}
+
+static uint64_t sim_now_us(void *hw) {
+    sim_t *s = hw;
+    return s->now_us;
+}
+
+const i2c_bus_ops_t sim_i2c_ops = {
+    .write = sim_i2c_write,
+    .read = sim_i2c_read,
+    .reset = sim_i2c_reset,
+    .now_us = sim_now_us,
+};
+
+
+static bool sim_fifo_full(void *hw) {
+    sim_t *s = hw;
+    s->now_us += SIM_PIO_POLL_US;
+    return s->now_us < s->stall_until;
+}
+
+static void sim_put(void *hw, uint32_t word) {
+    sim_t *s = hw;
+    s->now_us += SIM_PIO_WORD_US;
+    s->pio_words++;
+}
+
+const matrix_ops_t sim_matrix_ops = {
+    .fifo_full = sim_fifo_full,
+    .put = sim_put,
+    .now_us = sim_now_us,
+};
+
+
+static void sim_set_rgb(void *hw, bool r, bool g, bool b) {
+    sim_t *s = hw;
+    s->rgb[0] = r;
+    s->rgb[1] = g;
+    s->rgb[2] = b;
+}
+
+static bool sim_show_icon(void *hw, uint8_t icon) {
+    sim_t *s = hw;
+    if (icon >= MATRIX_ICON_COUNT) {
+        return false;
+    }
+    if (!matrix_send(&sim_matrix_ops, s, matrix_icons[icon], SIM_COLOR, MATRIX_TIMEOUT_US)) {
+        return false;
+    }
+    s->icon = icon;
+    if (s->supervisor) {
+        supervisor_beat(s->supervisor, TASK_MATRIX, (uint32_t)(s->now_us / 1000));
+    }
+    return true;
+}
+
+static void sim_buzzer(void *hw, bool on) {
+    sim_t *s = hw;
+    s->buzzer = on;
+}
+
+// Mesmo comportamento do wait_ms do firmware: executa a fila I2C e, quando
+// ela está vazia, dorme 1 ms.
+static void sim_wait_ms(void *hw, uint32_t ms) {
+    sim_t *s = hw;
+    uint64_t deadline = s->now_us + ms * 1000ull;
+
+    while (s->now_us < deadline) {
+        if (s->on_tick) {
+            s->on_tick(s, s->tick_ctx);
+        }
+        if (!i2c_bus_process(&s->bus)) {
+            if (s->supervisor) {
+                supervisor_beat(s->supervisor, TASK_BUS, (uint32_t)(s->now_us / 1000));
+            }
+            uint64_t step = deadline - s->now_us;
+            s->now_us += step < 1000 ? step : 1000;
+        }
+    }
+}
+
+const control_ops_t sim_control_ops = {
+    .set_rgb = sim_set_rgb,
+    .show_icon = sim_show_icon,
+    .buzzer = sim_buzzer,
+    .wait_ms = sim_wait_ms,
+};
+
+
+void sim_init(sim_t *s) {
+    *s = (sim_t){0};
+    s->icon = -1;
+
+    i2c_bus_init(&s->bus, &sim_i2c_ops, s);
+    ssd1306_init(&s->ssd, WIDTH, HEIGHT, false, 0x3C, &s->bus);
+    control_init(&s->control, &sim_control_ops, s, &s->ssd);
+
+    ssd1306_fill(&s->ssd, false);
+    s->control.display_ok = ssd1306_config(&s->ssd) && ssd1306_send_data(&s->ssd);
+    i2c_bus_flush(&s->bus);
+    s->control.display_ok = s->control.display_ok && !s->ssd.failed;
+    s->ssd.failed = false;
+}
+
+
+void sim_free(sim_t *s) {
+    free(s->ssd.ram_buffer);
+    s->ssd.ram_buffer = NULL;
+}
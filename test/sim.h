@@ -0,0 +1,64 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "control.h"
+#include "i2c_bus.h"
+#include "matrix.h"
+#include "ssd1306.h"
+#include "supervisor.h"
+
+// Placa simulada para os testes no host: relógio virtual, barramento I2C
+// com injeção de NAK e timeout e FIFO da PIO que pode travar. Cada
+// operação avança o relógio pelo tempo que levaria no hardware, então
+// os ciclos do laço principal podem ser medidos sem esperar.
+
+#define SIM_I2C_BYTE_US 23          // Um byte a 400 kHz
+#define SIM_I2C_RESET_US 100        // Pulsos de SCL e reinício do controlador
+#define SIM_PIO_POLL_US 1           // Leitura do estado da FIFO
+#define SIM_PIO_WORD_US 30          // Um LED (24 bits a 800 kHz)
+
+typedef struct sim sim_t;
+
+struct sim {
+    uint64_t now_us;                // Relógio virtual
+
+    // Barramento I2C
+    uint32_t nak_pending;           // Próximas transferências que recebem NAK
+    uint32_t timeout_pending;       // Próximas transferências que estouram o tempo
+    uint32_t i2c_transfers;         // Transferências concluídas
+    uint32_t i2c_resets;            // Recuperações do barramento
+
+    // FIFO da PIO
+    uint64_t stall_until;           // A FIFO fica cheia até este instante
+    uint32_t pio_words;             // Palavras aceitas pela FIFO
+
+    // Saídas
+    bool rgb[3];
+    int icon;                       // Último ícone exibido (-1 se nenhum)
+    bool buzzer;
+
+    // Heartbeats da matriz e do barramento, como no firmware (opcional)
+    supervisor_t *supervisor;
+
+    // Chamada a cada passo da espera, para aplicar eventos no tempo certo
+    void (*on_tick)(sim_t *s, void *ctx);
+    void *tick_ctx;
+
+    i2c_bus_t bus;
+    ssd1306_t ssd;
+    control_t control;
+};
+
+extern const i2c_bus_ops_t sim_i2c_ops;
+extern const matrix_ops_t sim_matrix_ops;
+extern const control_ops_t sim_control_ops;
+
+// Monta a placa simulada e configura o display como na partida a frio.
+void sim_init(sim_t *s);
+
+// Libera a memória alocada pelo display.
+void sim_free(sim_t *s);
+
+#endif // SIM_H
@@ -0,0 +1,13 @@
+#ifndef PICO_STDLIB_STUB_H
+#define PICO_STDLIB_STUB_H
+
+// Substitui o pico/stdlib.h do SDK nos testes no host: os módulos testados
+// só usam os tipos básicos que ele traz.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef unsigned int uint;
+
+#endif // PICO_STDLIB_STUB_H
@@ -0,0 +1,74 @@
+// font_glyph e os ícones gerados contra as tabelas escritas à mão que
+// existiam antes do gerador. Compilado com e sem FONT_RLE.
+
+#include <string.h>
+#include "check.h"
+#include "assets.h"
+#include "font.h"
+#include "reference/legacy_tables.h"
+
+#define LEGACY_ICONS (sizeof(legacy_numbers) / sizeof(legacy_numbers[0]))
+
+
+static void test_glyphs(void) {
+    CHECK_EQ(FONT_RLE, EXPECT_RLE);
+    CHECK_EQ(FONT_WIDTH, 8);
+    CHECK_EQ(FONT_HEIGHT, 8);
+
+    // Todos os 256 valores de char, inclusive os negativos. Espaço, dígitos
+    // e letras vêm da fonte anterior; fora do ASCII imprimível, o glifo vazio
+    for (int code = 0; code < 256; code++) {
+        char c = (char)code;
+        uint8_t scratch[FONT_WIDTH];
+        const uint8_t *glyph = font_glyph(c, scratch);
+        const uint8_t *legacy = &legacy_font[legacy_glyph(c) * 8];
+
+        if (legacy_glyph(c) || c == ' ' || code < 32 || code > 126) {
+            if (memcmp(glyph, legacy, FONT_WIDTH) != 0) {
+                fprintf(stderr, "glifo do código %d difere da fonte anterior\n", code);
+                check_failures++;
+            }
+        } else if (memcmp(glyph, legacy_font, FONT_WIDTH) == 0) {
+            // Pontuação e símbolos, que a fonte anterior não tinha
+            fprintf(stderr, "glifo do código %d está vazio\n", code);
+            check_failures++;
+        }
+    }
+
+    // '-' (oxigênio negativo, por exemplo): traço na linha 3 das colunas 0 a 6
+    static const uint8_t minus[FONT_WIDTH] = {0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00};
+    uint8_t scratch[FONT_WIDTH];
+    CHECK(memcmp(font_glyph('-', scratch), minus, FONT_WIDTH) == 0);
+}
+
+
+static void test_icons(void) {
+    CHECK_EQ(MATRIX_ICON_COUNT, LEGACY_ICONS);
+
+    for (size_t i = 0; i < LEGACY_ICONS && i < MATRIX_ICON_COUNT; i++) {
+        uint32_t mask = 0;
+        for (int led = 0; led < 25; led++) {
+            if (legacy_numbers[i][led]) {
+                mask |= 1u << led;
+            }
+        }
+        CHECK_EQ(matrix_icons[i], mask);
+    }
+
+    // Índices usados pelo firmware, na ordem da tabela anterior
+    CHECK_EQ(ICON_NUM_0, 0);
+    CHECK_EQ(ICON_NUM_9, 9);
+    CHECK_EQ(ICON_FELIZ, 10);
+    CHECK_EQ(ICON_TRISTE, 11);
+    CHECK_EQ(ICON_NORMAL, 12);
+    CHECK_EQ(ICON_MAIS, 13);
+    CHECK_EQ(ICON_MENOS, 14);
+    CHECK_EQ(ICON_MACA, 15);
+}
+
+
+int main(void) {
+    test_glyphs();
+    test_icons();
+    return CHECK_RESULT();
+}
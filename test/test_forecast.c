@@ -0,0 +1,265 @@
+// Precisão da previsão em curvas sintéticas: rampas, patamar com ruído,
+// resfriamento e degraus produzidos pelos botões (±5).
+
+#include <stdlib.h>
+#include "check.h"
+#include "monitor.h"
+
+#define SAMPLES 300
+
+typedef struct {
+    monitor_status_t status[SAMPLES];
+    compost_phase_t phase[SAMPLES];
+} outcome_t;
+
+typedef int (*curve_t)(int i, int arg);
+
+
+static void run(curve_t temp, curve_t umid, curve_t oxig, int arg, outcome_t *out) {
+    forecast_t f;
+    forecast_reset(&f);
+
+    for (int i = 0; i < SAMPLES; i++) {
+        readings_t r = {temp(i, arg), umid(i, arg), oxig(i, arg)};
+        forecast_update(&f, &r);
+        out->status[i] = apply_forecast(evaluate_status(&r), &f);
+        out->phase[i] = f.phase;
+    }
+}
+
+
+static int first(const outcome_t *o, monitor_status_t status) {
+    for (int i = 0; i < SAMPLES; i++) {
+        if (o->status[i] == status) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+
+static int temp_normal(int i, int arg) { return 39; }
+static int umid_normal(int i, int arg) { return 49; }
+static int oxig_normal(int i, int arg) { return 20; }
+
+
+// Degraus de +5 (um clique) na amostra 10, a partir do valor arg
+static int step_up(int i, int arg) { return i < 10 ? arg : arg + 5; }
+static int step_down(int i, int arg) { return i < 10 ? arg : arg - 5; }
+
+// Rampa de temperatura a partir de 40 °C com inclinação 1/arg por amostra
+static int temp_ramp(int i, int arg) { return 40 + i / arg; }
+
+// Oxigênio caindo a partir de 25% com inclinação 1/arg por amostra
+static int oxig_ramp(int i, int arg) { return 25 - i / arg; }
+
+// Patamar na faixa ideal com ruído de ±1 (gerador congruencial fixo)
+static unsigned noise_state;
+static int noise(void) {
+    noise_state = noise_state * 1103515245u + 12345u;
+    return (int)((noise_state >> 16) % 3) - 1;
+}
+static int temp_plateau(int i, int arg) { return 50 + noise(); }
+static int umid_plateau(int i, int arg) { return 60 + noise(); }
+static int oxig_plateau(int i, int arg) { return 20 + noise(); }
+
+// Aquecimento até 55 °C, patamar e resfriamento lento até 35 °C
+static int temp_cycle(int i, int arg) {
+    if (i < 15) return 40 + i;
+    if (i < 40) return 55;
+    int t = 55 - (i - 40) / 2;
+    return t > 35 ? t : 35;
+}
+
+
+static void test_samples_to(void) {
+    estimator_t e;
+    estimator_reset(&e);
+    CHECK_EQ(estimator_samples_to(&e, 61, true), -1);       // Sem amostras
+
+    estimator_update(&e, 50);
+    CHECK_EQ(estimator_samples_to(&e, 61, true), -1);       // Sem tendência
+    CHECK_EQ(estimator_samples_to(&e, 50, true), 0);        // No limite
+    CHECK_EQ(estimator_samples_to(&e, 45, true), 0);        // Além do limite superior
+    CHECK_EQ(estimator_samples_to(&e, 55, false), 0);       // Além do limite inferior
+    CHECK_EQ(estimator_samples_to(&e, 40, false), -1);
+
+    // Subindo 1 por amostra: aproxima do limite superior e se afasta do inferior
+    for (int v = 51; v <= 60; v++) {
+        estimator_update(&e, v);
+    }
+    int32_t eta = estimator_samples_to(&e, 70, true);
+    CHECK(eta > 0 && eta < 20);
+    CHECK_EQ(estimator_samples_to(&e, 40, false), -1);
+    CHECK_EQ(estimator_samples_to(&e, 50, true), 0);        // Passou do limite, mesmo com tendência
+
+    estimator_update(&e, 61);
+    int32_t next = estimator_samples_to(&e, 70, true);
+    CHECK(next >= 0 && next < eta);
+
+    // Caindo além do limite inferior: 0 enquanto a leitura continua caindo,
+    // -1 assim que ela volta a subir, mesmo com o nível ainda além do limite
+    estimator_reset(&e);
+    for (int v = 30; v >= 10; v--) {
+        estimator_update(&e, v);
+    }
+    CHECK_EQ(estimator_samples_to(&e, 14, false), 0);
+    for (int v = 10; v <= 13; v++) {
+        estimator_update(&e, v);
+    }
+    CHECK(estimator_level(&e) <= 14);
+    CHECK_EQ(estimator_samples_to(&e, 14, false), -1);
+
+    // Degrau para fora do limite: a leitura voltou, o nível ainda não
+    estimator_reset(&e);
+    for (int i = 0; i < 20; i++) {
+        estimator_update(&e, 65);
+    }
+    estimator_update(&e, 60);
+    CHECK(estimator_level(&e) >= 61);
+    CHECK_EQ(estimator_samples_to(&e, 61, true), -1);
+}
+
+
+static void test_tracking(void) {
+    estimator_t e;
+    estimator_reset(&e);
+
+    // Rampa de 1/2 por amostra: após assentar, nível e tendência acompanham a curva
+    for (int i = 0; i < 60; i++) {
+        estimator_update(&e, 40 + i / 2);
+    }
+    double trend = e.trend / 65536.0;
+    CHECK(trend > 0.4 && trend < 0.6);
+    CHECK(abs(estimator_level(&e) - (40 + 59 / 2)) <= 1);
+
+    // Patamar: a tendência volta a zero
+    for (int i = 0; i < 150; i++) {
+        estimator_update(&e, 70);
+    }
+    CHECK(abs(e.trend) < 65536 / 100);
+    CHECK_EQ(estimator_level(&e), 70);
+}
+
+
+static void test_steps(void) {
+    static const struct {
+        curve_t temp, umid, oxig;
+        int arg;
+    } steps[] = {
+        {step_up, umid_normal, oxig_normal, 39},
+        {step_up, umid_normal, oxig_normal, 50},
+        {step_up, umid_normal, oxig_normal, 55},
+        {temp_normal, step_up, oxig_normal, 49},
+        {temp_normal, step_up, oxig_normal, 60},
+        {temp_normal, umid_normal, step_down, 25},
+    };
+    outcome_t o;
+
+    for (size_t k = 0; k < sizeof(steps) / sizeof(steps[0]); k++) {
+        run(steps[k].temp, steps[k].umid, steps[k].oxig, steps[k].arg, &o);
+        if (first(&o, STATUS_WARNING) >= 0 || first(&o, STATUS_ALARM) >= 0) {
+            fprintf(stderr, "degrau %zu: aviso falso na amostra %d\n", k, first(&o, STATUS_WARNING));
+            check_failures++;
+        }
+    }
+
+    // Degraus que encerram o alarme (65 -> 60 °C, 10 -> 15% de oxigênio): o
+    // nível filtrado ainda está além do limite, mas não há aviso
+    static const struct {
+        curve_t temp, oxig;
+        int arg;
+    } clears[] = {
+        {step_down, oxig_normal, 65},
+        {temp_normal, step_up, 10},
+    };
+    for (size_t k = 0; k < sizeof(clears) / sizeof(clears[0]); k++) {
+        run(clears[k].temp, umid_normal, clears[k].oxig, clears[k].arg, &o);
+        CHECK_EQ(o.status[9], STATUS_ALARM);
+        for (int i = 10; i < SAMPLES; i++) {
+            if (o.status[i] == STATUS_WARNING || o.status[i] == STATUS_ALARM) {
+                fprintf(stderr, "fim do alarme %zu: estado %d na amostra %d\n", k, o.status[i], i);
+                check_failures++;
+                break;
+            }
+        }
+    }
+
+    // 39 -> 44 °C não chega a THERMO_ENTER: a fase não muda
+    run(step_up, umid_normal, oxig_normal, 39, &o);
+    for (int i = 0; i < SAMPLES; i++) {
+        CHECK_EQ(o.phase[i], PHASE_MESOPHILIC);
+    }
+}
+
+
+static void test_ramps(void) {
+    outcome_t o;
+
+    // Temperatura subindo 1, 1/2 e 1/4 por amostra: o aviso vem antes do alarme
+    static const struct { int den; int min_lead; } temp[] = {{1, 10}, {2, 20}, {4, 20}};
+    for (size_t k = 0; k < sizeof(temp) / sizeof(temp[0]); k++) {
+        run(temp_ramp, umid_normal, oxig_normal, temp[k].den, &o);
+        int warning = first(&o, STATUS_WARNING);
+        int alarm = first(&o, STATUS_ALARM);
+        CHECK(alarm > 0);
+        CHECK(warning >= 0 && alarm - warning >= temp[k].min_lead);
+        CHECK(alarm - warning <= FORECAST_HORIZON);          // Nem antes do horizonte
+        for (int i = warning; warning >= 0 && i < alarm; i++) {
+            CHECK_EQ(o.status[i], STATUS_WARNING);          // Sem alternar até o alarme
+        }
+    }
+
+    // Oxigênio caindo 1/2 por amostra
+    run(temp_normal, umid_normal, oxig_ramp, 2, &o);
+    int warning = first(&o, STATUS_WARNING);
+    int alarm = first(&o, STATUS_ALARM);
+    CHECK(alarm > 0);
+    CHECK(warning >= 0 && alarm - warning >= 5);
+}
+
+
+static void test_plateau(void) {
+    outcome_t o;
+    noise_state = 1;
+    run(temp_plateau, umid_plateau, oxig_plateau, 0, &o);
+    CHECK_EQ(first(&o, STATUS_WARNING), -1);
+    CHECK_EQ(first(&o, STATUS_ALARM), -1);
+    CHECK_EQ(o.phase[SAMPLES - 1], PHASE_THERMOPHILIC);
+}
+
+
+static void test_cooling(void) {
+    outcome_t o;
+    run(temp_cycle, umid_normal, oxig_normal, 0, &o);
+
+    CHECK_EQ(o.phase[4], PHASE_MESOPHILIC);
+    CHECK_EQ(o.phase[10], PHASE_THERMOPHILIC);
+    CHECK_EQ(o.phase[39], PHASE_THERMOPHILIC);
+    CHECK_EQ(o.phase[SAMPLES - 1], PHASE_COOLING);
+
+    // O aquecimento a 1 °C por amostra avisa; o patamar e o resfriamento não
+    for (int i = 30; i < SAMPLES; i++) {
+        CHECK(o.status[i] != STATUS_WARNING);
+    }
+
+    // Uma vez em resfriamento, não volta à fase termofílica
+    int cooling = 0;
+    while (o.phase[cooling] != PHASE_COOLING) {
+        cooling++;
+    }
+    for (int i = cooling; i < SAMPLES; i++) {
+        CHECK_EQ(o.phase[i], PHASE_COOLING);
+    }
+}
+
+
+int main(void) {
+    test_samples_to();
+    test_tracking();
+    test_steps();
+    test_ramps();
+    test_plateau();
+    test_cooling();
+    return CHECK_RESULT();
+}
@@ -0,0 +1,253 @@
+#!/usr/bin/env python3
+"""
+Testes de tools/gen_assets.py: as tabelas geradas a partir de assets/
+devem reproduzir a fonte e os ícones escritos à mão que existiam antes
+do gerador (test/reference/legacy_tables.h), com e sem --rle; entradas
+malformadas devem ser recusadas com arquivo e linha.
+
+Uso: python3 test/test_gen_assets.py
+"""
+
+import importlib.util
+import os
+import re
+import tempfile
+import unittest
+
+ROOT = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+FONT = os.path.join(ROOT, "assets", "font8x8.bdf")
+ICONS = os.path.join(ROOT, "assets", "icons.txt")
+LEGACY = os.path.join(ROOT, "test", "reference", "legacy_tables.h")
+
+spec = importlib.util.spec_from_file_location("gen_assets", os.path.join(ROOT, "tools", "gen_assets.py"))
+gen_assets = importlib.util.module_from_spec(spec)
+spec.loader.exec_module(gen_assets)
+
+
+def c_array(text, name):
+    """Valores do array C `name` (comentários removidos)."""
+    match = re.search(re.escape(name) + r"[^=]*=\s*\{(.*?)\};", text, re.S)
+    if not match:
+        raise AssertionError(f"array {name} não encontrado")
+    body = re.sub(r"//[^\n]*", "", match.group(1))
+    return [int(v, 0) for v in re.findall(r"0x[0-9a-fA-F]+|\d+", body)]
+
+
+def legacy_tables():
+    with open(LEGACY, encoding="utf-8") as f:
+        text = f.read()
+    font = c_array(text, "legacy_font[]")
+    numbers = c_array(text, "legacy_numbers[][25]")
+    icons = [sum(1 << i for i, v in enumerate(numbers[k:k + 25]) if v) for k in range(0, len(numbers), 25)]
+    return font, icons
+
+
+def legacy_glyph(code):
+    """Mesmo mapeamento de legacy_glyph() em legacy_tables.h (char com sinal)."""
+    c = chr(code) if code < 128 else ""
+    if "A" <= c <= "Z":
+        return ord(c) - ord("A") + 11
+    if "a" <= c <= "z":
+        return ord(c) - ord("a") + 37
+    if "0" <= c <= "9":
+        return ord(c) - ord("0") + 1
+    return 0
+
+
+def rle_decode(data, start, width):
+    out = []
+    i = start
+    while len(out) < width:
+        run, value = data[i], data[i + 1]
+        out += [value] * run
+        i += 2
+    return out[:width]
+
+
+class GeneratedTables(unittest.TestCase):
+    def generate(self, rle):
+        with tempfile.TemporaryDirectory() as out:
+            gen_assets.generate(FONT, ICONS, out, rle)
+            with open(os.path.join(out, "assets.h"), encoding="utf-8") as f:
+                header = f.read()
+            with open(os.path.join(out, "assets.c"), encoding="utf-8") as f:
+                source = f.read()
+        return header, source
+
+    def glyph(self, source, rle, code):
+        index = c_array(source, "font_index[128]")
+        data = c_array(source, "font_data[]")
+        glyph = index[code] if code < 128 else 0
+        if rle:
+            offsets = c_array(source, "font_offsets[FONT_GLYPH_COUNT]")
+            return rle_decode(data, offsets[glyph], 8)
+        return data[glyph * 8:glyph * 8 + 8]
+
+    def check_font(self, rle):
+        font, _ = legacy_tables()
+        header, source = self.generate(rle)
+        self.assertIn(f"#define FONT_RLE         {1 if rle else 0}", header)
+        for code in range(256):
+            with self.subTest(code=code, rle=rle):
+                glyph = self.glyph(source, rle, code)
+                if legacy_glyph(code) or code == ord(" ") or not 32 <= code <= 126:
+                    # Espaço, dígitos e letras vêm da fonte anterior; fora do
+                    # ASCII imprimível, o glifo vazio
+                    legacy = font[legacy_glyph(code) * 8:legacy_glyph(code) * 8 + 8]
+                    self.assertEqual(glyph, legacy)
+                else:
+                    # Pontuação e símbolos, que a fonte anterior não tinha
+                    self.assertTrue(any(glyph), chr(code))
+        self.assertEqual(self.glyph(source, rle, ord("-")), [0x08] * 7 + [0])
+
+    def test_font_plain(self):
+        self.check_font(False)
+
+    def test_font_rle(self):
+        self.check_font(True)
+
+    def test_icons(self):
+        _, icons = legacy_tables()
+        for rle in (False, True):
+            header, source = self.generate(rle)
+            self.assertEqual(c_array(source, "matrix_icons[MATRIX_ICON_COUNT]"), icons)
+            self.assertIn(f"#define MATRIX_ICON_COUNT {len(icons)}", header)
+        names = re.findall(r"#define ICON_(\w+) (\d+)", header)
+        self.assertEqual([int(i) for _, i in names], list(range(len(icons))))
+        self.assertEqual(names[10:], [("FELIZ", "10"), ("TRISTE", "11"), ("NORMAL", "12"),
+                                      ("MAIS", "13"), ("MENOS", "14"), ("MACA", "15")])
+
+    def test_write_if_changed(self):
+        with tempfile.TemporaryDirectory() as out:
+            path = os.path.join(out, "assets.h")
+            gen_assets.write_if_changed(path, "abc")
+            # Sem mudança: o conteúdo fica, mas a data é atualizada para a
+            # saída não parecer mais antiga que as entradas do gerador
+            os.utime(path, (0, 0))
+            gen_assets.write_if_changed(path, "abc")
+            self.assertNotEqual(os.stat(path).st_mtime, 0)
+            with open(path, encoding="utf-8") as f:
+                self.assertEqual(f.read(), "abc")
+            gen_assets.write_if_changed(path, "abcd")
+            with open(path, encoding="utf-8") as f:
+                self.assertEqual(f.read(), "abcd")
+
+
+class RunLength(unittest.TestCase):
+    def round_trip(self, columns):
+        encoded = gen_assets.rle_encode(columns)
+        self.assertEqual(len(encoded) % 2, 0)
+        self.assertTrue(all(0 < run <= 255 for run in encoded[0::2]))
+        self.assertEqual(rle_decode(encoded + [0, 0], 0, len(columns)) if columns else [], columns)
+        return encoded
+
+    def test_round_trip(self):
+        self.assertEqual(self.round_trip([]), [])
+        self.assertEqual(self.round_trip([0] * 8), [8, 0])
+        self.assertEqual(self.round_trip([1, 2, 2, 3]), [1, 1, 2, 2, 1, 3])
+        self.round_trip([0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x7f, 0x00])
+
+    def test_long_runs_split(self):
+        encoded = self.round_trip([5] * 600)
+        self.assertEqual(encoded, [255, 5, 255, 5, 90, 5])
+
+    def test_pseudo_random(self):
+        state = 1
+        for _ in range(200):
+            columns = []
+            for _ in range(state % 40):
+                state = (state * 1103515245 + 12345) % 2 ** 31
+                columns.append((state >> 16) % 4)
+            self.round_trip(columns)
+
+
+BDF_HEAD = """STARTFONT 2.1
+FONT test
+SIZE 8 75 75
+FONTBOUNDINGBOX 8 8 0 0
+STARTPROPERTIES 1
+DEFAULT_CHAR 32
+ENDPROPERTIES
+"""
+
+BDF_SPACE = """STARTCHAR space
+ENCODING 32
+BBX 8 8 0 0
+BITMAP
+00
+00
+00
+00
+00
+00
+00
+00
+ENDCHAR
+"""
+
+
+class MalformedInput(unittest.TestCase):
+    def write(self, directory, name, text):
+        path = os.path.join(directory, name)
+        with open(path, "w", encoding="utf-8") as f:
+            f.write(text)
+        return path
+
+    def assert_fails(self, parser, text, message, line=None):
+        with tempfile.TemporaryDirectory() as d:
+            path = self.write(d, "input", text)
+            with self.assertRaises(SystemExit) as ctx:
+                parser(path)
+        error = str(ctx.exception.code)
+        self.assertIn(message, error)
+        self.assertTrue(error.startswith(path + ":"))
+        if line is not None:
+            self.assertTrue(error.startswith(f"{path}:{line}:"), error)
+
+    def test_valid_minimal_font(self):
+        with tempfile.TemporaryDirectory() as d:
+            path = self.write(d, "font.bdf", BDF_HEAD + BDF_SPACE + "ENDFONT\n")
+            width, height, default, glyphs = gen_assets.parse_bdf(path)
+        self.assertEqual((width, height, default), (8, 8, 32))
+        self.assertEqual(glyphs, {32: [0] * 8})
+
+    def test_bdf_errors(self):
+        bdf = gen_assets.parse_bdf
+        self.assert_fails(bdf, BDF_SPACE.replace("ENCODING", "X"), "BITMAP antes de FONTBOUNDINGBOX", 4)
+        self.assert_fails(bdf, "STARTFONT 2.1\n", "FONTBOUNDINGBOX ausente")
+        self.assert_fails(bdf, BDF_HEAD + "STARTCHAR a\nENCODING 97\nBITMAP\n", "BITMAP antes de FONTBOUNDINGBOX/BBX", 10)
+        self.assert_fails(bdf, BDF_HEAD + "ENDCHAR\n", "ENDCHAR sem BITMAP", 8)
+        self.assert_fails(bdf, BDF_HEAD + BDF_SPACE.replace("00\nENDCHAR", "ENDCHAR"), "esperadas 8 linhas", 19)
+        self.assert_fails(bdf, BDF_HEAD + BDF_SPACE.replace("BBX 8 8 0 0", "BBX 8 8 2 0").replace("00\nENDCHAR", "ff\nENDCHAR"),
+                          "fora de FONTBOUNDINGBOX", 20)
+        self.assert_fails(bdf, BDF_HEAD.replace("FONTBOUNDINGBOX 8 8", "FONTBOUNDINGBOX 8 16") + BDF_SPACE, "altura 16")
+        self.assert_fails(bdf, BDF_HEAD.replace("DEFAULT_CHAR 32", "DEFAULT_CHAR 63") + BDF_SPACE, "DEFAULT_CHAR 63")
+        self.assert_fails(bdf, BDF_HEAD + BDF_SPACE.replace("00\nENDCHAR", "zz\nENDCHAR"), "BITMAP inválida", 19)
+        self.assert_fails(bdf, BDF_HEAD + BDF_SPACE.replace("ENCODING 32\n", ""), "ENCODING ausente")
+
+    def test_icon_errors(self):
+        icons = gen_assets.parse_icons
+        five = "#####\n" * 5
+        self.assert_fails(icons, "icon A\n#####\n", "ícone A incompleto", 2)
+        self.assert_fails(icons, "icon A\n###\nicon B\n", "ícone A incompleto", 3)
+        self.assert_fails(icons, "icon A\n" + five + "##\n", "linha inválida", 7)
+        self.assert_fails(icons, "icon A\n####.x\n", "linha inválida", 2)
+        self.assert_fails(icons, "icon A\n####\n####\n####\n####\n##########\n", "mais de 25 pixels", 6)
+        self.assert_fails(icons, "icon 1A\n", "esperado 'icon NOME'", 1)
+        self.assert_fails(icons, "icon A B\n", "esperado 'icon NOME'", 1)
+        self.assert_fails(icons, "icon A\n" + five + "icon A\n" + five, "nomes de ícones repetidos")
+
+    def test_icon_comments(self):
+        with tempfile.TemporaryDirectory() as d:
+            text = ("# comentário\n#\nicon A # primeiro\n"
+                    "#....\n"
+                    ".....\n"
+                    ".....\n"
+                    ".....\n"
+                    ".....\n")
+            path = self.write(d, "icons.txt", text)
+            self.assertEqual(gen_assets.parse_icons(path), [("A", 1)])
+
+
+if __name__ == "__main__":
+    unittest.main()
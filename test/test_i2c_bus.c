@@ -0,0 +1,334 @@
+// Fila de transações do barramento I2C contra um barramento simulado que
+// registra cada transferência e falha quando instruído.
+
+#include <string.h>
+#include "check.h"
+#include "i2c_bus.h"
+#include "ssd1306.h"
+
+#define LOG_LEN 64
+
+typedef struct {
+    uint64_t now_us;
+    uint32_t fail_mask;             // Bit i: a transferência i falha
+    uint32_t calls;
+    uint32_t resets;
+    struct {
+        uint8_t address;
+        uint8_t first;              // Primeiro byte escrito (0 em leituras)
+        size_t len;
+        bool nostop;
+        bool read;
+    } log[LOG_LEN];
+} mock_t;
+
+
+static int mock_transfer(mock_t *m, uint8_t address, const uint8_t *src, size_t len, bool nostop, bool read) {
+    uint32_t n = m->calls++;
+    if (n < LOG_LEN) {
+        m->log[n].address = address;
+        m->log[n].first = src && len ? src[0] : 0;
+        m->log[n].len = len;
+        m->log[n].nostop = nostop;
+        m->log[n].read = read;
+    }
+    m->now_us += 23 * (len + 1);
+    if (n < 32 && (m->fail_mask & (1u << n))) {
+        return -1;
+    }
+    return (int)len;
+}
+
+static int mock_write(void *hw, uint8_t address, const uint8_t *src, size_t len, bool nostop, uint32_t timeout_us) {
+    return mock_transfer(hw, address, src, len, nostop, false);
+}
+
+static int mock_read(void *hw, uint8_t address, uint8_t *dst, size_t len, uint32_t timeout_us) {
+    memset(dst, 0xA5, len);
+    return mock_transfer(hw, address, NULL, len, false, true);
+}
+
+static void mock_reset(void *hw) {
+    mock_t *m = hw;
+    m->resets++;
+}
+
+static uint64_t mock_now_us(void *hw) {
+    mock_t *m = hw;
+    return m->now_us;
+}
+
+static const i2c_bus_ops_t mock_ops = {
+    .write = mock_write,
+    .read = mock_read,
+    .reset = mock_reset,
+    .now_us = mock_now_us,
+};
+
+
+typedef struct {
+    int calls;
+    int last_result;
+} done_t;
+
+static void on_done(int result, void *ctx) {
+    done_t *d = ctx;
+    d->calls++;
+    d->last_result = result;
+}
+
+
+static void setup(i2c_bus_t *bus, mock_t *m) {
+    memset(m, 0, sizeof(*m));
+    i2c_bus_init(bus, &mock_ops, m);
+}
+
+
+static bool write_byte(i2c_bus_t *bus, uint8_t address, i2c_priority_t prio, uint8_t value) {
+    return i2c_bus_write(bus, address, prio, &value, 1, NULL, NULL);
+}
+
+
+static void test_priority_and_order(void) {
+    i2c_bus_t bus;
+    mock_t m;
+    setup(&bus, &m);
+
+    write_byte(&bus, 0x3C, I2C_PRIO_DISPLAY, 1);
+    write_byte(&bus, 0x3C, I2C_PRIO_DISPLAY, 2);
+    write_byte(&bus, 0x48, I2C_PRIO_SENSOR, 3);
+    write_byte(&bus, 0x3C, I2C_PRIO_DISPLAY, 4);
+    write_byte(&bus, 0x48, I2C_PRIO_SENSOR, 5);
+    i2c_bus_flush(&bus);
+
+    // Sensores primeiro; dentro da mesma prioridade, ordem de chegada
+    static const uint8_t order[] = {3, 5, 1, 2, 4};
+    CHECK_EQ(m.calls, 5);
+    for (size_t i = 0; i < sizeof(order); i++) {
+        CHECK_EQ(m.log[i].first, order[i]);
+    }
+    CHECK_EQ(bus.stats.submitted, 5);
+    CHECK_EQ(bus.stats.completed, 5);
+    CHECK_EQ(i2c_bus_free(&bus), I2C_BUS_QUEUE_LEN);
+}
+
+
+static void test_seq_wraparound(void) {
+    i2c_bus_t bus;
+    mock_t m;
+    setup(&bus, &m);
+    bus.next_seq = UINT32_MAX - 1;
+
+    for (uint8_t v = 1; v <= 4; v++) {
+        write_byte(&bus, 0x3C, I2C_PRIO_DISPLAY, v);
+    }
+    i2c_bus_flush(&bus);
+    for (uint8_t v = 1; v <= 4; v++) {
+        CHECK_EQ(m.log[v - 1].first, v);
+    }
+}
+
+
+static void test_retry_and_reset(void) {
+    i2c_bus_t bus;
+    mock_t m;
+    done_t d = {0};
+
+    // Uma falha isolada é repetida sem recuperar o barramento
+    setup(&bus, &m);
+    m.fail_mask = 1u << 0;
+    uint8_t data[2] = {7, 8};
+    i2c_bus_write(&bus, 0x3C, I2C_PRIO_DISPLAY, data, 2, on_done, &d);
+    i2c_bus_flush(&bus);
+    CHECK_EQ(m.calls, 2);
+    CHECK_EQ(d.calls, 1);
+    CHECK_EQ(d.last_result, 2);
+    CHECK_EQ(bus.stats.errors, 1);
+    CHECK_EQ(bus.stats.completed, 1);
+    CHECK_EQ(m.resets, 0);
+
+    // Falhas seguidas esgotam as tentativas e recuperam o barramento
+    setup(&bus, &m);
+    d = (done_t){0};
+    m.fail_mask = 0x3;
+    i2c_bus_write(&bus, 0x3C, I2C_PRIO_DISPLAY, data, 2, on_done, &d);
+    write_byte(&bus, 0x3C, I2C_PRIO_DISPLAY, 9);
+    i2c_bus_flush(&bus);
+    CHECK_EQ(d.calls, 1);
+    CHECK(d.last_result < 0);
+    CHECK_EQ(bus.stats.failed, 1);
+    CHECK_EQ(bus.stats.errors, I2C_BUS_MAX_ATTEMPTS);
+    CHECK_EQ(m.resets, 1);
+    CHECK_EQ(m.log[2].first, 9);                // A fila segue após o descarte
+    CHECK_EQ(bus.stats.completed, 1);
+}
+
+
+static void test_full_and_oversize(void) {
+    i2c_bus_t bus;
+    mock_t m;
+    setup(&bus, &m);
+
+    for (int i = 0; i < I2C_BUS_QUEUE_LEN; i++) {
+        CHECK(write_byte(&bus, 0x3C, I2C_PRIO_DISPLAY, (uint8_t)i));
+    }
+    CHECK_EQ(i2c_bus_free(&bus), 0);
+    CHECK(!write_byte(&bus, 0x3C, I2C_PRIO_DISPLAY, 0xFF));
+    CHECK_EQ(bus.stats.rejected, 1);
+    i2c_bus_flush(&bus);
+
+    uint8_t big[I2C_BUS_MAX_DATA + 1] = {0};
+    CHECK(i2c_bus_write(&bus, 0x3C, I2C_PRIO_DISPLAY, big, I2C_BUS_MAX_DATA, NULL, NULL));
+    CHECK(!i2c_bus_write(&bus, 0x3C, I2C_PRIO_DISPLAY, big, I2C_BUS_MAX_DATA + 1, NULL, NULL));
+    CHECK(i2c_bus_write_prefixed(&bus, 0x3C, I2C_PRIO_DISPLAY, 0x40, big, I2C_BUS_MAX_DATA - 1, NULL, NULL));
+    CHECK(!i2c_bus_write_prefixed(&bus, 0x3C, I2C_PRIO_DISPLAY, 0x40, big, I2C_BUS_MAX_DATA, NULL, NULL));
+    CHECK_EQ(bus.stats.rejected, 3);
+}
+
+
+static void test_read(void) {
+    i2c_bus_t bus;
+    mock_t m;
+    done_t d = {0};
+    setup(&bus, &m);
+
+    uint8_t reg = 0x10;
+    uint8_t dst[3] = {0};
+    CHECK(i2c_bus_read(&bus, 0x48, I2C_PRIO_SENSOR, &reg, 1, dst, sizeof(dst), on_done, &d));
+    i2c_bus_flush(&bus);
+
+    CHECK_EQ(m.calls, 2);
+    CHECK(!m.log[0].read && m.log[0].nostop);   // Repeated start entre escrita e leitura
+    CHECK(m.log[1].read);
+    CHECK_EQ(m.log[1].len, 3);
+    CHECK_EQ(dst[2], 0xA5);
+    CHECK_EQ(d.last_result, 3);
+}
+
+
+static void requeue(int result, void *ctx) {
+    i2c_bus_t *bus = ctx;
+    // A posição já foi liberada: o callback pode enfileirar a próxima transação
+    CHECK_EQ(i2c_bus_free(bus), I2C_BUS_QUEUE_LEN);
+    write_byte(bus, 0x3C, I2C_PRIO_DISPLAY, 2);
+}
+
+static void test_callback_requeue(void) {
+    i2c_bus_t bus;
+    mock_t m;
+    setup(&bus, &m);
+
+    uint8_t v = 1;
+    i2c_bus_write(&bus, 0x3C, I2C_PRIO_DISPLAY, &v, 1, requeue, &bus);
+    i2c_bus_flush(&bus);
+    CHECK_EQ(m.calls, 2);
+    CHECK_EQ(m.log[1].first, 2);
+}
+
+
+static void test_cancel(void) {
+    i2c_bus_t bus;
+    mock_t m;
+    done_t a = {0}, b = {0};
+    setup(&bus, &m);
+
+    uint8_t v = 1;
+    i2c_bus_write(&bus, 0x3C, I2C_PRIO_DISPLAY, &v, 1, on_done, &a);
+    i2c_bus_write(&bus, 0x48, I2C_PRIO_SENSOR, &v, 1, on_done, &b);
+    i2c_bus_write(&bus, 0x3C, I2C_PRIO_DISPLAY, &v, 1, on_done, &a);
+
+    CHECK_EQ(i2c_bus_cancel(&bus, &a), 2);
+    CHECK_EQ(bus.stats.cancelled, 2);
+    i2c_bus_flush(&bus);
+    CHECK_EQ(m.calls, 1);
+    CHECK_EQ(a.calls, 0);                       // Canceladas não chamam o callback
+    CHECK_EQ(b.calls, 1);
+}
+
+
+static void test_utilization(void) {
+    i2c_bus_t bus;
+    mock_t m;
+    setup(&bus, &m);
+
+    uint8_t data[99] = {0};
+    i2c_bus_write(&bus, 0x3C, I2C_PRIO_DISPLAY, data, sizeof(data), NULL, NULL);
+    i2c_bus_flush(&bus);                        // 100 bytes x 23 us
+    m.now_us += 2300;                           // Mesmo tempo ocioso
+    CHECK_EQ(i2c_bus_utilization(&bus), 50);
+    m.now_us += 1000;
+    CHECK_EQ(i2c_bus_utilization(&bus), 0);     // Nova janela
+}
+
+
+// Um bloco de dados do display que falha não é repetido, já que o ponteiro
+// de escrita do display pode ter avançado; os blocos seguintes saem do
+// barramento e o próximo quadro é enviado inteiro.
+static void test_display_frame_drop(void) {
+    i2c_bus_t bus;
+    mock_t m;
+    ssd1306_t ssd;
+    setup(&bus, &m);
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, &bus);
+
+    // Transferência 0: janela; 1: primeiro bloco, que falha uma vez só
+    m.fail_mask = 0x2;
+    CHECK(ssd1306_send_data(&ssd));
+    CHECK_EQ(bus.count, ssd.pages + 1);
+    i2c_bus_flush(&bus);
+
+    CHECK(ssd.failed);
+    CHECK_EQ(m.calls, 2);                       // Sem nova tentativa nem blocos depois do perdido
+    CHECK_EQ(bus.stats.failed, 1);
+    CHECK_EQ(bus.stats.cancelled, ssd.pages - 1);
+    CHECK_EQ(i2c_bus_free(&bus), I2C_BUS_QUEUE_LEN);
+
+    // Falha no meio do quadro (quarto bloco): os anteriores já foram enviados
+    ssd.failed = false;
+    m.calls = 0;
+    m.fail_mask = 1u << 4;
+    CHECK(ssd1306_send_data(&ssd));
+    i2c_bus_flush(&bus);
+    CHECK(ssd.failed);
+    CHECK_EQ(m.calls, 5);
+    CHECK_EQ(bus.stats.failed, 2);
+    CHECK_EQ(bus.stats.cancelled, (ssd.pages - 1) + (ssd.pages - 4));
+
+    // Os comandos continuam com duas tentativas: a janela é reenviada inteira
+    ssd.failed = false;
+    m.calls = 0;
+    m.fail_mask = 0x1;
+    CHECK(ssd1306_send_data(&ssd));
+    i2c_bus_flush(&bus);
+    CHECK(!ssd.failed);
+    CHECK_EQ(m.calls, 2 + ssd.pages);
+
+    // Recuperação: reconfigura e envia o quadro completo
+    ssd.failed = false;
+    m.calls = 0;
+    m.fail_mask = 0;
+    CHECK(ssd1306_config(&ssd));
+    CHECK(ssd1306_send_data(&ssd));
+    i2c_bus_flush(&bus);
+    CHECK(!ssd.failed);
+    CHECK_EQ(m.calls, 1 + 1 + ssd.pages);
+    for (uint32_t i = 2; i < m.calls; i++) {
+        CHECK_EQ(m.log[i].first, 0x40);
+        CHECK_EQ(m.log[i].len, ssd.width + 1);
+    }
+    free(ssd.ram_buffer);
+}
+
+
+int main(void) {
+    test_priority_and_order();
+    test_seq_wraparound();
+    test_retry_and_reset();
+    test_full_and_oversize();
+    test_read();
+    test_callback_requeue();
+    test_cancel();
+    test_utilization();
+    test_display_frame_drop();
+    return CHECK_RESULT();
+}
@@ -0,0 +1,294 @@
+// Supervisão e reinício a quente: prazos com tempo virtual, integridade do
+// estado preservado, limite de reinícios seguidos e retomada do controle.
+
+#include <string.h>
+#include "check.h"
+#include "sim.h"
+#include "supervisor.h"
+
+static const uint32_t budget[TASK_COUNT] = {
+    [TASK_LOOP] = 2500,
+    [TASK_BUS] = 2000,
+    [TASK_MATRIX] = 2500,
+};
+
+
+// Simula o reinício: a RAM não inicializada mantém o conteúdo byte a byte
+static void reset_ram(retained_t *after, const retained_t *before) {
+    memcpy(after, before, sizeof(*after));
+}
+
+
+static void fill_control(control_t *c) {
+    control_init(c, &sim_control_ops, NULL, NULL);
+    c->temperatura = 52;
+    c->umidade = 66;
+    c->oxigenio = 17;
+    for (int i = 0; i < 20; i++) {
+        readings_t r = {40 + i, 50 + i / 2, 20 - i / 4};
+        forecast_update(&c->forecast, &r);
+    }
+    c->status = STATUS_WARNING;
+    c->i2c_errors = 7;
+    c->matrix_errors = 3;
+}
+
+
+static void test_seal_and_reset(void) {
+    retained_t ram;
+    memset(&ram, 0xA5, sizeof(ram));            // Conteúdo indefinido após energizar
+    CHECK(!retained_valid(&ram));
+    CHECK_EQ(retained_boot(&ram, false), BOOT_COLD);
+    CHECK(retained_valid(&ram));                // Reiniciado e selado na partida a frio
+    CHECK_EQ(ram.restarts, 0);
+    CHECK_EQ(ram.late_task, TASK_COUNT);
+
+    control_t c;
+    fill_control(&c);
+    control_save(&c, &ram);
+
+    retained_t after;
+    reset_ram(&after, &ram);
+    CHECK(retained_valid(&after));
+    CHECK_EQ(retained_boot(&after, true), BOOT_WARM);
+    CHECK_EQ(after.restarts, 1);
+    CHECK(retained_valid(&after));
+
+    // Estado íntegro, mas o reinício não foi pelo watchdog (reset ou energização)
+    reset_ram(&after, &ram);
+    CHECK_EQ(retained_boot(&after, false), BOOT_COLD);
+    CHECK_EQ(after.leituras.temperatura, 0);
+}
+
+
+static void test_corruption(void) {
+    control_t c;
+    fill_control(&c);
+    retained_t sealed;
+    retained_boot(&sealed, false);
+    control_save(&c, &sealed);
+
+    // Qualquer bit alterado, inclusive na marca e no próprio CRC, leva à partida a frio
+    for (size_t i = 0; i < sizeof(retained_t); i++) {
+        if (i >= offsetof(retained_t, crc) + sizeof(uint32_t)) {
+            break;                              // Preenchimento após o CRC não é coberto
+        }
+        retained_t r;
+        reset_ram(&r, &sealed);
+        ((uint8_t *)&r)[i] ^= 0x10;
+        if (retained_valid(&r)) {
+            fprintf(stderr, "byte %zu alterado não foi detectado\n", i);
+            check_failures++;
+        }
+        CHECK_EQ(retained_boot(&r, true), BOOT_COLD);
+        CHECK_EQ(r.leituras.temperatura, 0);
+    }
+
+    retained_t r;
+    reset_ram(&r, &sealed);
+    r.magic = 0;
+    CHECK(!retained_valid(&r));
+
+    // Tarefa atrasada fora da faixa, mesmo com CRC correto
+    reset_ram(&r, &sealed);
+    r.late_task = TASK_COUNT + 1;
+    retained_seal(&r);
+    CHECK(!retained_valid(&r));
+}
+
+
+static void test_restart_limit(void) {
+    control_t c;
+    fill_control(&c);
+    retained_t ram;
+    retained_boot(&ram, false);
+    control_save(&c, &ram);
+
+    for (int i = 1; i <= RETAINED_MAX_RESTARTS; i++) {
+        CHECK_EQ(retained_boot(&ram, true), BOOT_WARM);
+        CHECK_EQ(ram.restarts, i);
+        control_save(&c, &ram);                 // O laço volta a gravar o estado
+    }
+    CHECK_EQ(retained_boot(&ram, true), BOOT_RESTART_LIMIT);
+    CHECK(retained_valid(&ram));
+    CHECK_EQ(ram.restarts, 0);
+    CHECK_EQ(ram.leituras.temperatura, 0);      // Estado que provocava os reinícios descartado
+
+    // Depois da partida a frio a contagem recomeça
+    control_save(&c, &ram);
+    CHECK_EQ(retained_boot(&ram, true), BOOT_WARM);
+    CHECK_EQ(ram.restarts, 1);
+}
+
+
+static void test_restore(void) {
+    control_t before;
+    fill_control(&before);
+    retained_t ram, after;
+    retained_boot(&ram, false);
+    control_save(&before, &ram);
+
+    reset_ram(&after, &ram);
+    CHECK_EQ(retained_boot(&after, true), BOOT_WARM);
+
+    control_t c;
+    control_init(&c, &sim_control_ops, NULL, NULL);
+    control_restore(&c, &after);
+    CHECK_EQ(c.temperatura, 52);
+    CHECK_EQ(c.umidade, 66);
+    CHECK_EQ(c.oxigenio, 17);
+    CHECK_EQ(c.status, STATUS_WARNING);
+    CHECK_EQ(c.i2c_errors, 7);
+    CHECK_EQ(c.matrix_errors, 3);
+    CHECK(memcmp(&c.forecast, &before.forecast, sizeof(forecast_t)) == 0);
+
+    // A previsão continua de onde parou
+    readings_t r = {60, 61, 15};
+    forecast_update(&c.forecast, &r);
+    forecast_update(&before.forecast, &r);
+    CHECK_EQ(c.forecast.eta, before.forecast.eta);
+    CHECK_EQ(c.forecast.phase, before.forecast.phase);
+}
+
+
+static void test_deadlines(void) {
+    supervisor_t s;
+
+    supervisor_init(&s, budget, 1000);
+    CHECK_EQ(supervisor_check(&s, 3000), TASK_COUNT);
+    CHECK_EQ(supervisor_check(&s, 3001), TASK_BUS);
+
+    // Cada tarefa falha sozinha quando só ela deixa de sinalizar
+    for (int late = 0; late < TASK_COUNT; late++) {
+        supervisor_init(&s, budget, 0);
+        for (uint32_t now = 0; now <= budget[late] + 1000; now += 50) {
+            for (int t = 0; t < TASK_COUNT; t++) {
+                if (t != late) {
+                    supervisor_beat(&s, (task_id_t)t, now);
+                }
+            }
+            CHECK_EQ(supervisor_check(&s, now), now > budget[late] ? late : TASK_COUNT);
+        }
+    }
+
+    // Contador de ms dando a volta
+    supervisor_init(&s, budget, UINT32_MAX - 100);
+    CHECK_EQ(supervisor_check(&s, 500), TASK_COUNT);
+    CHECK_EQ(supervisor_check(&s, 2000), TASK_BUS);
+}
+
+
+static void test_tick(void) {
+    supervisor_t s;
+    retained_t r;
+    retained_boot(&r, false);
+    supervisor_init(&s, budget, 0);
+
+    CHECK(supervisor_tick(&s, &r, 1000));
+    CHECK_EQ(r.late_task, TASK_COUNT);
+
+    supervisor_beat(&s, TASK_BUS, 2000);
+    supervisor_beat(&s, TASK_LOOP, 2000);
+    CHECK(!supervisor_tick(&s, &r, 2600));      // Só a matriz ficou sem sinalizar
+    CHECK_EQ(r.late_task, TASK_MATRIX);
+    CHECK(retained_valid(&r));
+
+    // A primeira tarefa atrasada é a que fica registrada
+    CHECK(!supervisor_tick(&s, &r, 9000));
+    CHECK_EQ(r.late_task, TASK_MATRIX);
+}
+
+
+// Placa simulada com a interrupção do supervisor a cada 100 ms de tempo virtual
+typedef struct {
+    supervisor_t supervisor;
+    retained_t retained;
+    uint64_t next_tick_us;
+    uint64_t expired_us;            // Instante em que o watchdog deixou de ser alimentado (0 = nunca)
+} board_t;
+
+static void board_tick(sim_t *s, void *ctx) {
+    board_t *b = ctx;
+    while (s->now_us >= b->next_tick_us) {
+        if (!b->expired_us && !supervisor_tick(&b->supervisor, &b->retained, (uint32_t)(s->now_us / 1000))) {
+            b->expired_us = s->now_us;
+        }
+        b->next_tick_us += 100000;
+    }
+}
+
+static void board_init(sim_t *s, board_t *b) {
+    sim_init(s);
+    memset(b, 0, sizeof(*b));
+    retained_boot(&b->retained, false);
+    supervisor_init(&b->supervisor, budget, 0);
+    s->supervisor = &b->supervisor;
+    s->on_tick = board_tick;
+    s->tick_ctx = b;
+}
+
+// Laço principal até until_us ou até o watchdog deixar de ser alimentado
+static void board_run(sim_t *s, board_t *b, uint64_t until_us) {
+    while (s->now_us < until_us && !b->expired_us) {
+        supervisor_beat(&b->supervisor, TASK_LOOP, (uint32_t)(s->now_us / 1000));
+        control_cycle(&s->control);
+        control_save(&s->control, &b->retained);
+    }
+}
+
+
+static void test_board(void) {
+    static sim_t s;
+    static board_t b;
+
+    // Funcionamento normal, inclusive em alarme (ciclo de 1,5 s): nenhum reinício
+    board_init(&s, &b);
+    board_run(&s, &b, 30000000);
+    CHECK_EQ(b.expired_us, 0);
+    sim_free(&s);
+
+    // FIFO da PIO travada: só a matriz deixa de sinalizar
+    board_init(&s, &b);
+    s.control.oxigenio = 20;
+    board_run(&s, &b, 5000000);
+    uint64_t stall = s.now_us;
+    s.stall_until = stall + 60000000;
+    board_run(&s, &b, stall + 10000000);
+    CHECK(b.expired_us > stall);
+    CHECK(b.expired_us <= stall + budget[TASK_MATRIX] * 1000ull + 200000);
+    CHECK_EQ(b.retained.late_task, TASK_MATRIX);
+    CHECK(retained_valid(&b.retained));
+    sim_free(&s);
+
+    // Laço principal travado: a fila I2C ainda esvazia, mas o laço não sinaliza
+    board_init(&s, &b);
+    s.control.oxigenio = 20;
+    board_run(&s, &b, 5000000);
+    uint64_t hang = s.now_us;
+    while (!b.expired_us && s.now_us < hang + 10000000) {
+        sim_control_ops.wait_ms(&s, 100);
+    }
+    CHECK(b.expired_us > hang);
+    CHECK(b.expired_us <= hang + budget[TASK_LOOP] * 1000ull + 200000);
+    CHECK_EQ(b.retained.late_task, TASK_LOOP);
+
+    // Após o reinício, a placa retoma as mesmas leituras
+    retained_t after;
+    reset_ram(&after, &b.retained);
+    CHECK_EQ(retained_boot(&after, true), BOOT_WARM);
+    CHECK_EQ(after.late_task, TASK_LOOP);
+    CHECK_EQ(after.leituras.oxigenio, 20);
+    sim_free(&s);
+}
+
+
+int main(void) {
+    test_seal_and_reset();
+    test_corruption();
+    test_restart_limit();
+    test_restore();
+    test_deadlines();
+    test_tick();
+    test_board();
+    return CHECK_RESULT();
+}
@@ -0,0 +1,269 @@
+#!/usr/bin/env python3
+"""
+Gera as tabelas de fonte e de ícones usadas pelo firmware.
+
+Lê uma fonte BDF e um arquivo de ícones da matriz de LEDs e escreve
+assets.h/assets.c com tabelas `const`, que ficam na flash:
+
+- font_index: tabela indexada pelo código ASCII (0-127) com o número do
+  glifo; caracteres ausentes apontam para o DEFAULT_CHAR da fonte.
+- font_data: glifos em colunas de 1 byte (bit 0 = linha de cima),
+  o formato esperado pelo SSD1306. Com --rle os glifos são compactados
+  em pares (repetições, valor) e font_offsets indica o início de cada um.
+- matrix_icons: um inteiro por ícone, bit i = LED i da matriz.
+
+Uso: gen_assets.py --font fonte.bdf --icons icones.txt --out DIR [--rle]
+"""
+
+import argparse
+import os
+import sys
+
+MATRIX_LEDS = 25
+
+
+def fail(path, line, msg):
+    sys.exit(f"{path}:{line}: {msg}")
+
+
+def parse_bdf(path):
+    """Retorna (largura, altura, caractere padrão, {código: colunas})."""
+    box = None
+    default_char = None
+    glyphs = {}
+    encoding = bbx = bitmap = None
+
+    with open(path, encoding="ascii") as f:
+        lines = f.read().splitlines()
+
+    for n, line in enumerate(lines, 1):
+        fields = line.split()
+        if not fields:
+            continue
+        key = fields[0]
+
+        if bitmap is not None and key != "ENDCHAR":
+            try:
+                bitmap.append(int(key, 16))
+            except ValueError:
+                fail(path, n, f"linha de BITMAP inválida: {key!r}")
+        elif key == "FONTBOUNDINGBOX":
+            box = [int(v) for v in fields[1:5]]
+        elif key == "DEFAULT_CHAR":
+            default_char = int(fields[1])
+        elif key == "STARTCHAR":
+            encoding = bbx = None
+        elif key == "ENCODING":
+            encoding = int(fields[1])
+        elif key == "BBX":
+            bbx = [int(v) for v in fields[1:5]]
+        elif key == "BITMAP":
+            if box is None or bbx is None:
+                fail(path, n, "BITMAP antes de FONTBOUNDINGBOX/BBX")
+            bitmap = []
+        elif key == "ENDCHAR":
+            if bitmap is None:
+                fail(path, n, "ENDCHAR sem BITMAP")
+            if encoding is None:
+                fail(path, n, "ENCODING ausente")
+            if 0 <= encoding < 128:
+                glyphs[encoding] = bdf_columns(path, n, box, bbx, bitmap)
+            bitmap = None
+
+    if box is None:
+        fail(path, 1, "FONTBOUNDINGBOX ausente")
+    width, height = box[0], box[1]
+    if height > 8:
+        fail(path, 1, f"altura {height} não suportada (máximo 8, uma página do display)")
+    if default_char is None:
+        default_char = ord(" ")
+    if default_char not in glyphs:
+        fail(path, 1, f"DEFAULT_CHAR {default_char} não definido na fonte")
+    return width, height, default_char, glyphs
+
+
+def bdf_columns(path, line, box, bbx, rows):
+    """Converte as linhas do BITMAP em colunas posicionadas na célula da fonte."""
+    fw, fh, fx, fy = box
+    w, h, x0, y0 = bbx
+    if len(rows) != h:
+        fail(path, line, f"esperadas {h} linhas no BITMAP, encontradas {len(rows)}")
+
+    row_bits = (w + 7) // 8 * 8
+    top = (fh + fy) - (y0 + h)              # Linha da célula onde o glifo começa
+    left = x0 - fx
+    columns = [0] * fw
+
+    for r, bits in enumerate(rows):
+        for c in range(w):
+            if bits & (1 << (row_bits - 1 - c)):
+                x, y = left + c, top + r
+                if not (0 <= x < fw and 0 <= y < fh):
+                    fail(path, line, "glifo fora de FONTBOUNDINGBOX")
+                columns[x] |= 1 << y
+    return columns
+
+
+def rle_encode(columns):
+    """Compacta as colunas em pares (repetições, valor)."""
+    out = []
+    i = 0
+    while i < len(columns):
+        run = 1
+        while i + run < len(columns) and columns[i + run] == columns[i] and run < 255:
+            run += 1
+        out += [run, columns[i]]
+        i += run
+    return out
+
+
+def parse_icons(path):
+    """Retorna a lista [(nome, máscara)] dos ícones da matriz."""
+    icons = []
+    name = None
+    pixels = ""
+
+    with open(path, encoding="utf-8") as f:
+        lines = f.read().splitlines()
+
+    for n, raw in enumerate(lines, 1):
+        # Comentários começam com "# " (linhas de pixels não têm espaços)
+        line = raw.strip()
+        if not line or line == "#" or line.startswith("# "):
+            continue
+        if line.startswith("icon "):
+            fields = line.split("#", 1)[0].split()
+            if len(fields) != 2 or not fields[1].isidentifier():
+                fail(path, n, "esperado 'icon NOME'")
+            if name is not None:
+                fail(path, n, f"ícone {name} incompleto")
+            name = fields[1]
+            pixels = ""
+            continue
+        if name is None or any(ch not in "#." for ch in line):
+            fail(path, n, f"linha inválida: {raw!r}")
+        pixels += line
+        if len(pixels) > MATRIX_LEDS:
+            fail(path, n, f"ícone {name} com mais de {MATRIX_LEDS} pixels")
+        if len(pixels) == MATRIX_LEDS:
+            mask = sum(1 << i for i, ch in enumerate(pixels) if ch == "#")
+            icons.append((name, mask))
+            name = None
+
+    if name is not None:
+        fail(path, len(lines), f"ícone {name} incompleto")
+    if len({n for n, _ in icons}) != len(icons):
+        fail(path, 1, "nomes de ícones repetidos")
+    return icons
+
+
+def c_array(values, fmt, per_line):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append("    " + ", ".join(fmt.format(v) for v in values[i:i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def char_comment(code):
+    return repr(chr(code)) if 32 <= code < 127 else str(code)
+
+
+def generate(font_path, icons_path, out_dir, rle):
+    width, height, default_char, glyphs = parse_bdf(font_path)
+    icons = parse_icons(icons_path)
+
+    # O caractere padrão fica no glifo 0, para que códigos ausentes apontem para ele
+    codes = [default_char] + sorted(c for c in glyphs if c != default_char)
+    number = {code: i for i, code in enumerate(codes)}
+    index = [number.get(code, 0) for code in range(128)]
+    if len(codes) > 256:
+        sys.exit("mais de 256 glifos")
+
+    data = []
+    offsets = []
+    data_lines = []
+    for code in codes:
+        columns = rle_encode(glyphs[code]) if rle else glyphs[code]
+        offsets.append(len(data))
+        data += columns
+        data_lines.append("    " + ", ".join(f"0x{v:02x}" for v in columns) + f", // {char_comment(code)}")
+
+    base = os.path.splitext(os.path.basename(__file__))[0]
+    header = [
+        f"// Gerado por tools/{base}.py a partir de {os.path.basename(font_path)} e",
+        f"// {os.path.basename(icons_path)}. Não edite: altere os arquivos em assets/.",
+        "",
+        "#ifndef ASSETS_H",
+        "#define ASSETS_H",
+        "",
+        "#include <stdint.h>",
+        "",
+        f"#define FONT_WIDTH       {width}",
+        f"#define FONT_HEIGHT      {height}",
+        f"#define FONT_GLYPH_COUNT {len(codes)}",
+        f"#define FONT_RLE         {1 if rle else 0}",
+        "",
+        "extern const uint8_t font_index[128];",
+        "extern const uint8_t font_data[];",
+    ]
+    if rle:
+        header.append("extern const uint16_t font_offsets[FONT_GLYPH_COUNT];")
+    header += ["", f"#define MATRIX_ICON_COUNT {len(icons)}", ""]
+    header += [f"#define ICON_{name} {i}" for i, (name, _) in enumerate(icons)]
+    header += ["", "extern const uint32_t matrix_icons[MATRIX_ICON_COUNT];", "", "#endif // ASSETS_H", ""]
+
+    source = [
+        f"// Gerado por tools/{base}.py. Não edite.",
+        "",
+        '#include "assets.h"',
+        "",
+        "const uint8_t font_index[128] = {",
+        c_array(index, "{:d}", 16),
+        "};",
+        "",
+        "const uint8_t font_data[] = {",
+        *data_lines,
+        "};",
+        "",
+    ]
+    if rle:
+        source += ["const uint16_t font_offsets[FONT_GLYPH_COUNT] = {", c_array(offsets, "{:d}", 16), "};", ""]
+    source += ["const uint32_t matrix_icons[MATRIX_ICON_COUNT] = {"]
+    source += [f"    0x{mask:07x}, // {name}" for name, mask in icons]
+    source += ["};", ""]
+
+    os.makedirs(out_dir, exist_ok=True)
+    write_if_changed(os.path.join(out_dir, "assets.h"), "\n".join(header))
+    write_if_changed(os.path.join(out_dir, "assets.c"), "\n".join(source))
+
+
+def write_if_changed(path, text):
+    """Só reescreve o arquivo quando o conteúdo muda.
+
+    Sem mudança, apenas atualiza a data de modificação: o build usa as
+    saídas para decidir se o gerador precisa rodar, e uma saída mais antiga
+    que as entradas faria o gerador rodar de novo a cada build.
+    """
+    try:
+        with open(path, encoding="utf-8") as f:
+            if f.read() == text:
+                os.utime(path)
+                return
+    except FileNotFoundError:
+        pass
+    with open(path, "w", encoding="utf-8") as f:
+        f.write(text)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--font", required=True, help="fonte no formato BDF")
+    parser.add_argument("--icons", required=True, help="ícones da matriz de LEDs")
+    parser.add_argument("--out", required=True, help="diretório de saída")
+    parser.add_argument("--rle", action="store_true", help="compacta os glifos com run-length")
+    args = parser.parse_args()
+    generate(args.font, args.icons, args.out, args.rle)
+
+
+if __name__ == "__main__":
+    main()